@@ -7,7 +7,10 @@
 // Updated for Qt 6.6+ by ChatGPT (2025)
 
 #include "audiosampler.h"
+#include "dft/sampleconversion.h"
+#include "dft/overlapsave.h"
 
+#include <algorithm>
 #include <QDebug>
 #include <QMediaDevices>
 #include <QAudioDevice>
@@ -22,7 +25,10 @@ AudioSampler::AudioSampler(QObject *parent)
 {
     _started = false;
     _samplesToWait = 4096;
+    _hopSize = 0;
+    _fixedPoint = false;
     _samples = new std::vector<float>();
+    _samples->reserve(_samplesToWait);
     _audioSource = nullptr;
 }
 
@@ -33,12 +39,25 @@ AudioSampler::~AudioSampler() {
 
 void AudioSampler::elapsed() {
     if (isSignalConnected(QMetaMethod::fromSignal(&AudioSampler::samplesCollected))) {
-        std::vector<float> *samplesCopy = new std::vector<float>(*_samples);
-        emit samplesCollected(samplesCopy);
+        emit samplesCollected(*_samples);
     }
     _samples->clear();
 }
 
+void AudioSampler::hopElapsed() {
+    if (isSignalConnected(QMetaMethod::fromSignal(&AudioSampler::hopCollected))) {
+        emit hopCollected(_hop);
+    }
+    _hop.clear();
+}
+
+void AudioSampler::fixedPointElapsed() {
+    if (isSignalConnected(QMetaMethod::fromSignal(&AudioSampler::fixedPointSamplesCollected))) {
+        emit fixedPointSamplesCollected(_fixedPointSamples);
+    }
+    _fixedPointSamples.clear();
+}
+
 bool AudioSampler::start() {
     if (_started)
         return true;
@@ -90,7 +109,9 @@ bool AudioSampler::start() {
 
     // --- Création du flux ---
     _audioSource = new QAudioSource(_device, format, this);
-    _audioSource->setBufferSize(_samplesToWait * sizeof(qint16));
+    // en mode glissant, un petit tampon pour recevoir les sauts régulièrement et non par rafales
+    quint32 bufferSamples = _hopSize ? std::min(_samplesToWait, 4 * _hopSize) : _samplesToWait;
+    _audioSource->setBufferSize(bufferSamples * sizeof(qint16));
     _audioSource->setVolume(1.0);
 
     // --- Démarrage ---
@@ -118,6 +139,10 @@ void AudioSampler::stop() {
     }
 
     _samples->clear();
+    _hop.clear();
+    _fixedPointSamples.clear();
+    if (_filter)
+        _filter->reset();
     this->close();
 
     _started = false;
@@ -137,7 +162,56 @@ quint32 AudioSampler::samplesToWait() const {
 }
 
 void AudioSampler::setSamplesToWait(quint32 value) {
+    if (_samplesToWait == value)
+        return;
+
     _samplesToWait = value;
+    _samples->reserve(_samplesToWait);
+    _fixedPointSamples.reserve(_samplesToWait);
+    emit samplesToWaitChanged(value);
+}
+
+quint32 AudioSampler::hopSize() const {
+    return _hopSize;
+}
+
+// Prend effet immédiatement pour les signaux, au prochain start() pour la taille du tampon audio
+void AudioSampler::setHopSize(quint32 value) {
+    if (_hopSize == value)
+        return;
+
+    _hopSize = value;
+    _hop.clear();
+    _hop.reserve(_hopSize);
+    _samples->clear();
+    emit hopSizeChanged(value);
+}
+
+bool AudioSampler::fixedPoint() const {
+    return _fixedPoint;
+}
+
+void AudioSampler::setFixedPoint(bool value) {
+    if (_fixedPoint == value)
+        return;
+
+    _fixedPoint = value;
+    _fixedPointSamples.clear();
+    _fixedPointSamples.reserve(_samplesToWait);
+    _samples->clear();
+    emit fixedPointChanged(value);
+}
+
+bool AudioSampler::hasFilter() const {
+    return bool(_filter);
+}
+
+// Les tables du filtre (FFT des partitions) sont calculées ici une fois, jamais pendant la capture
+void AudioSampler::setFilter(const std::vector<float> &taps, quint32 blockSize) {
+    if (taps.empty())
+        _filter.reset();
+    else
+        _filter.reset(new OverlapSaveFilter(taps.data(), unsigned(taps.size()), blockSize));
 }
 
 qint64 AudioSampler::readData(char *data, qint64 maxlen) {
@@ -146,6 +220,26 @@ qint64 AudioSampler::readData(char *data, qint64 maxlen) {
     return 0;
 }
 
+// === Conversion int16 → float par blocs ===
+// Remplit 'buffer' jusqu'à 'target' échantillons avec le noyau SIMD de conversion,
+// filtrés sur place par 'filter' s'il y en a un,
+// et appelle 'full' à chaque fois qu'il est plein (au moins un échantillon par tour).
+template <typename Full>
+static void collectSamples(std::vector<float> &buffer, size_t target, const qint16 *samples, qint64 count, OverlapSaveFilter *filter, Full full) {
+    while (count > 0) {
+        const size_t used = buffer.size();
+        const size_t take = std::min<size_t>(size_t(count), target > used ? target - used : 1);
+        buffer.resize(used + take);
+        convertSamples(samples, buffer.data() + used, unsigned(take));
+        if (filter)
+            filter->process(buffer.data() + used, unsigned(take));
+        samples += take;
+        count -= qint64(take);
+        if (buffer.size() >= target)
+            full();
+    }
+}
+
 qint64 AudioSampler::writeData(const char *data, qint64 len) {
     if (!_started || !_audioSource)
         return 0;
@@ -153,11 +247,20 @@ qint64 AudioSampler::writeData(const char *data, qint64 len) {
     const qint16 *samples = reinterpret_cast<const qint16*>(data);
     qint64 sampleCount = len / 2;
 
-    for (qint64 i = 0; i < sampleCount; ++i) {
-        _samples->push_back(static_cast<float>(samples[i]));
-        if (_samples->size() >= _samplesToWait)
-            elapsed();
+    if (_hopSize) {
+        collectSamples(_hop, _hopSize, samples, sampleCount, _filter.get(), [this] { hopElapsed(); });
+        return len;
+    }
+
+    if (_fixedPoint) {
+        for (qint64 i = 0; i < sampleCount; ++i) {
+            _fixedPointSamples.push_back(samples[i]);
+            if (_fixedPointSamples.size() >= _samplesToWait)
+                fixedPointElapsed();
+        }
+        return len;
     }
 
+    collectSamples(*_samples, _samplesToWait, samples, sampleCount, _filter.get(), [this] { elapsed(); });
     return len;
 }
@@ -5,11 +5,22 @@
 #include <QAudioSource>
 #include <QAudioDevice>
 #include <QObject>
+#include <memory>
 #include <vector>
 
+class OverlapSaveFilter;
+
 // === Classe AudioSampler (Qt6) ===
 // Capture du son depuis le périphérique d’entrée (loopback / VB-Audio / Mixage stéréo)
 // Émet périodiquement un signal "samplesCollected" contenant un bloc d’échantillons.
+// Le bloc n'est valide que pendant l'émission (il est réutilisé ensuite, sans allocation).
+// En mode glissant (hopSize > 0), émet "hopCollected" tous les hopSize échantillons
+// à la place, pour un analyseur qui fait glisser sa fenêtre (SlidingDft).
+// En mode virgule fixe (fixedPoint, par trames seulement), émet "fixedPointSamplesCollected"
+// avec les échantillons int16 tels quels, sans conversion en float (FixedPointFft).
+// Un filtre FIR optionnel (setFilter) est appliqué aux échantillons float juste après
+// la conversion, avant l'analyse : convolution overlap-save par blocs (OverlapSaveFilter),
+// avec un retard fixe d'un bloc quelle que soit la longueur du filtre.
 
 class AudioSampler : public QIODevice
 {
@@ -27,8 +38,26 @@ public:
     quint32 samplesToWait() const;
     void setSamplesToWait(quint32 value);
 
+    // 0 = blocs entiers de samplesToWait, sinon 64 ... 256 par exemple
+    quint32 hopSize() const;
+    void setHopSize(quint32 value);
+
+    bool fixedPoint() const;
+    void setFixedPoint(bool value);
+
+    // Coefficients du filtre FIR (pondération A/C, calibration micro, isolation de bande...),
+    // vide = pas de filtre. blockSize (puissance de 2) = retard ajouté, en échantillons.
+    // Ne s'applique pas au mode virgule fixe.
+    bool hasFilter() const;
+    void setFilter(const std::vector<float> &taps, quint32 blockSize = 256);
+
 signals:
-    void samplesCollected(std::vector<float> *samples);
+    void samplesCollected(const std::vector<float> &samples);
+    void samplesToWaitChanged(quint32 value);
+    void hopCollected(const std::vector<float> &samples);
+    void hopSizeChanged(quint32 value);
+    void fixedPointSamplesCollected(const std::vector<qint16> &samples);
+    void fixedPointChanged(bool value);
 
 protected:
     qint64 readData(char *data, qint64 maxlen) override;
@@ -36,12 +65,19 @@ protected:
 
 private slots:
     void elapsed();
+    void hopElapsed();
+    void fixedPointElapsed();
 
 private:
     bool _started;
     quint32 _samplesToWait;
+    quint32 _hopSize;
+    bool _fixedPoint;
 
     std::vector<float> *_samples;
+    std::vector<float> _hop;
+    std::vector<qint16> _fixedPointSamples;
+    std::unique_ptr<OverlapSaveFilter> _filter;
 
     QAudioFormat _format;
     QAudioDevice _device;
@@ -0,0 +1,10 @@
+TEMPLATE = app
+TARGET = fft-benchmark
+
+QT = core
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+SOURCES += main.cpp
+
+include(../dft/dft.pri)
@@ -0,0 +1,142 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+// Benchmark of every DFT engine, printed as JSON so that runs of
+// different releases can be compared.
+// With --check, runs the accuracy suite instead (DftConformance) and
+// exits with 1 if an engine is less accurate than it should be.
+//
+// Usage: fft-benchmark [--check] [--min-log2 6] [--max-log2 20] [--engine name] [--runs 101]
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTextStream>
+
+#include "dft/conformance.h"
+#include "dft/cpufeatures.h"
+#include "dft/dftfactory.h"
+
+// The plain DFT is O(N²), larger sizes would take minutes
+static const unsigned maxTrivialSize = 1u << 12;
+
+static QJsonObject benchmark(DftFactory::Engine engine, Dft *dft, unsigned runs) {
+    Dft::Timing timing = Dft::measure(dft, runs);
+
+    QJsonObject result;
+    result["engine"] = DftFactory::name(engine);
+    result["size"] = (qint64)dft->sampleCount();
+    result["min_ns"] = timing.minNs;
+    result["median_ns"] = timing.medianNs;
+    result["p99_ns"] = timing.p99Ns;
+    result["ns_per_point"] = timing.medianNs / dft->sampleCount();
+    result["calls_per_run"] = (qint64)timing.callsPerRun;
+    result["runs"] = (qint64)timing.runs;
+    return result;
+}
+
+static QJsonObject check(const DftConformance::Case &accuracy) {
+    QJsonObject result;
+    result["engine"] = QString::fromStdString(accuracy.engine);
+    result["size"] = (qint64)accuracy.size;
+    result["signal"] = DftConformance::name(accuracy.signal);
+    result["path"] = QString::fromStdString(accuracy.path);
+    result["max_error_db"] = accuracy.result.maxErrorDb;
+    result["rms_error_db"] = accuracy.result.rmsErrorDb;
+    result["snr_db"] = accuracy.result.snrDb;
+    result["minimum_snr_db"] = accuracy.minimumSnrDb;
+    result["passed"] = accuracy.passed;
+    return result;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("fft-benchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times every DFT engine and prints the results as JSON.");
+    parser.addHelpOption();
+    QCommandLineOption minOption("min-log2", "Smallest size, as a power of 2.", "n", "6");
+    QCommandLineOption maxOption("max-log2", "Largest size, as a power of 2.", "n", "20");
+    QCommandLineOption engineOption("engine", "Only benchmark this engine.", "name");
+    QCommandLineOption runsOption("runs", "Timed runs per engine and size.", "n", "101");
+    QCommandLineOption checkOption("check", "Check the accuracy of the engines instead of timing them.");
+    parser.addOption(minOption);
+    parser.addOption(maxOption);
+    parser.addOption(engineOption);
+    parser.addOption(runsOption);
+    parser.addOption(checkOption);
+    parser.process(app);
+
+    unsigned minLog2 = parser.value(minOption).toUInt();
+    unsigned maxLog2 = parser.value(maxOption).toUInt();
+    unsigned runs = parser.value(runsOption).toUInt();
+
+    std::vector<DftFactory::Engine> engines = DftFactory::engines();
+    if (parser.isSet(engineOption)) {
+        QByteArray name = parser.value(engineOption).toLatin1();
+        DftFactory::Engine engine = DftFactory::engineByName(name.constData());
+        if (engine == DftFactory::Engine::Automatic && name != "automatic") {
+            QTextStream(stderr) << "unknown engine: " << name << Qt::endl;
+            return 1;
+        }
+        engines = { engine };
+    }
+
+    bool checking = parser.isSet(checkOption);
+    bool ok = true;
+    QJsonArray results;
+    if (checking) {
+        // The double engines, SlidingDft and GoertzelBank are checked along with the whole list
+        std::vector<unsigned> sizes = DftConformance::testSizes(minLog2, maxLog2);
+        ok = DftConformance::run(engines, sizes, !parser.isSet(engineOption), [&](const DftConformance::Case &accuracy) {
+            results.append(check(accuracy));
+        });
+    }
+    else {
+        for (DftFactory::Engine engine : engines) {
+            for (unsigned log2sc = minLog2; log2sc <= maxLog2; log2sc++) {
+                unsigned sampleCount = 1u << log2sc;
+                if (engine == DftFactory::Engine::Trivial && sampleCount > maxTrivialSize) {
+                    continue;
+                }
+
+                Dft *dft = DftFactory::create(sampleCount, engine);
+                if (!dft) {
+                    continue;
+                }
+                results.append(benchmark(engine, dft, runs));
+                delete dft;
+            }
+        }
+    }
+
+    QJsonObject report;
+    report["qt_version"] = qVersion();
+    report["cpu_architecture"] = QSysInfo::currentCpuArchitecture();
+    report["cpu_name"] = QString::fromStdString(cpuName());
+    report["build_abi"] = QSysInfo::buildAbi();
+    report["simd_level"] = simdLevelName(simdLevel());
+    if (checking) {
+        report["passed"] = ok;
+    }
+    report["results"] = results;
+
+    QTextStream(stdout) << QJsonDocument(report).toJson(QJsonDocument::Indented);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <complex>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Allocator for buffers that are read by the SIMD kernels.
+// 64 bytes is a cache line and the width of an AVX-512 register.
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    inline AlignedAllocator() { }
+
+    template <typename U>
+    inline AlignedAllocator(const AlignedAllocator<U, Alignment> &) { }
+
+    inline T *allocate(std::size_t n) {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    inline void deallocate(T *p, std::size_t) {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    inline bool operator==(const AlignedAllocator<U, Alignment> &) const {
+        return true;
+    }
+
+    template <typename U>
+    inline bool operator!=(const AlignedAllocator<U, Alignment> &) const {
+        return false;
+    }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T> >;
+
+#endif // ALIGNEDALLOCATOR_H
@@ -0,0 +1,190 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef BITREVERSAL_H
+#define BITREVERSAL_H
+
+#include <complex>
+#include <utility>
+#include <vector>
+
+// Bit-reversal permutation of 2^log2n values, without a full-size index table.
+// Up to 2^12 values everything is in cache: the index is split in two halves
+// and reversed with two tables of ~sqrt(N) entries.
+// From 2^13 on the COBRA blocking is used: the index is split into 5 low bits,
+// the middle bits and 5 high bits, and every value of the middle bits is a
+// 32 x 32 tile that is gathered in a buffer on the stack with contiguous reads,
+// then written out with contiguous writes. Nothing strides through the whole
+// array, so it stays fast when N is far bigger than the caches.
+// The member functions are const and reentrant.
+class BitReversal {
+private:
+    static const unsigned blockLog2 = 5;
+    static const unsigned blockSize = 1u << blockLog2;
+    static const unsigned blockedMinLog2 = 13;
+
+    unsigned _log2n;
+    // Direct path: i = h << _lowBits | l  ->  _low[l] | _high[h]
+    unsigned _lowBits;
+    std::vector<unsigned> _low;
+    std::vector<unsigned> _high;
+    // Blocked path: reversed blockLog2-bit values
+    unsigned _block[blockSize];
+
+    static inline unsigned reverseBits(unsigned input, unsigned b) {
+        unsigned result = 0;
+        for (unsigned i = 0; i < b; i++) {
+            result = (result << 1) | ((input >> i) & 1);
+        }
+        return result;
+    }
+
+    // Next value of a counter that counts with its b bits reversed
+    static inline unsigned nextReversed(unsigned j, unsigned b) {
+        unsigned bit = (1u << b) >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        return j | bit;
+    }
+
+    // tile[rev(a) * B + d] = load(d << (log2n - b) | c << b | a)
+    template <typename Load, typename T>
+    inline void gather(Load load, std::complex<T> *tile, unsigned c) const {
+        for (unsigned d = 0; d < blockSize; d++) {
+            const unsigned first = (d << (_log2n - blockLog2)) + (c << blockLog2);
+            for (unsigned a = 0; a < blockSize; a++) {
+                tile[_block[a] * blockSize + d] = load(first + a);
+            }
+        }
+    }
+
+    // Writes a gathered tile to its bit-reversed place, of middle bits 'cr'
+    template <typename T>
+    inline void scatter(const std::complex<T> *tile, std::complex<T> *out, unsigned cr) const {
+        for (unsigned a = 0; a < blockSize; a++) {
+            std::complex<T> *dst = out + (a << (_log2n - blockLog2)) + (cr << blockLog2);
+            const std::complex<T> *row = tile + a * blockSize;
+            for (unsigned d = 0; d < blockSize; d++) {
+                dst[d] = row[_block[d]];
+            }
+        }
+    }
+
+public:
+    explicit inline BitReversal(unsigned log2n) : _log2n(log2n) {
+        _lowBits = log2n / 2;
+        unsigned highBits = log2n - _lowBits;
+        if (log2n < blockedMinLog2) {
+            _low.resize(1u << _lowBits);
+            for (unsigned l = 0; l < _low.size(); l++) {
+                _low[l] = reverseBits(l, _lowBits) << highBits;
+            }
+            _high.resize(1u << highBits);
+            for (unsigned h = 0; h < _high.size(); h++) {
+                _high[h] = reverseBits(h, highBits);
+            }
+        }
+        for (unsigned a = 0; a < blockSize; a++) {
+            _block[a] = reverseBits(a, blockLog2);
+        }
+    }
+
+    // Calls f(i, rev(i)) for every i, in a cache friendly order
+    template <typename F>
+    inline void forEach(F f) const {
+        if (_log2n < blockedMinLog2) {
+            for (unsigned h = 0; h < _high.size(); h++) {
+                for (unsigned l = 0; l < _low.size(); l++) {
+                    f((h << _lowBits) | l, _low[l] | _high[h]);
+                }
+            }
+            return;
+        }
+
+        const unsigned middleBits = _log2n - 2 * blockLog2;
+        const unsigned highShift = _log2n - blockLog2;
+        for (unsigned c = 0, cr = 0; c < (1u << middleBits); c++, cr = nextReversed(cr, middleBits)) {
+            for (unsigned d = 0; d < blockSize; d++) {
+                unsigned i = (d << highShift) | (c << blockLog2);
+                unsigned j = (cr << blockLog2) | _block[d];
+                for (unsigned a = 0; a < blockSize; a++) {
+                    f(i | a, j | (_block[a] << highShift));
+                }
+            }
+        }
+    }
+
+    // out[rev(i)] = load(i), out of place
+    template <typename Load, typename T>
+    inline void load(Load load, std::complex<T> *out) const {
+        if (_log2n < blockedMinLog2) {
+            forEach([&](unsigned i, unsigned j) { out[j] = load(i); });
+            return;
+        }
+
+        alignas(64) std::complex<T> tile[blockSize * blockSize];
+        const unsigned middleBits = _log2n - 2 * blockLog2;
+        for (unsigned c = 0, cr = 0; c < (1u << middleBits); c++, cr = nextReversed(cr, middleBits)) {
+            gather(load, tile, c);
+            scatter(tile, out, cr);
+        }
+    }
+
+    // out[rev(i)] = in[i]
+    template <typename In, typename T>
+    inline void copy(const In *in, std::complex<T> *out) const {
+        load([in](unsigned i) { return in[i]; }, out);
+    }
+
+    // out[rev(i)] = in[i] * window[i]: the window costs no pass of its own
+    template <typename In, typename T>
+    inline void copy(const In *in, const In *window, std::complex<T> *out) const {
+        load([in, window](unsigned i) { return in[i] * window[i]; }, out);
+    }
+
+    // data[rev(i)] = data[i], in place.
+    // Tiles c and rev(c) trade places, so both are gathered before writing.
+    template <typename T>
+    inline void permute(std::complex<T> *data) const {
+        if (_log2n < blockedMinLog2) {
+            forEach([&](unsigned i, unsigned j) {
+                if (i < j) {
+                    std::swap(data[i], data[j]);
+                }
+            });
+            return;
+        }
+
+        auto element = [data](unsigned i) { return data[i]; };
+        alignas(64) std::complex<T> tile[blockSize * blockSize];
+        alignas(64) std::complex<T> mirror[blockSize * blockSize];
+        const unsigned middleBits = _log2n - 2 * blockLog2;
+        for (unsigned c = 0, cr = 0; c < (1u << middleBits); c++, cr = nextReversed(cr, middleBits)) {
+            if (cr < c) {
+                continue;
+            }
+            gather(element, tile, c);
+            if (cr != c) {
+                gather(element, mirror, cr);
+                scatter(mirror, data, c);
+            }
+            scatter(tile, data, cr);
+        }
+    }
+};
+
+#endif // BITREVERSAL_H
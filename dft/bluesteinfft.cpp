@@ -0,0 +1,77 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <cmath>
+#include "bluesteinfft.h"
+
+static unsigned convolutionSize(unsigned sampleCount) {
+    unsigned size = 1;
+    while (size < 2 * sampleCount - 1) {
+        size *= 2;
+    }
+    return size;
+}
+
+BluesteinFft::BluesteinFft(unsigned sampleCount) : Dft(sampleCount), _fft(convolutionSize(sampleCount)) {
+    const double pi = std::acos(-1.0);
+    const unsigned M = _fft.sampleCount();
+
+    // exp(-πjn²/N), with n² taken mod 2N to keep the phase accurate
+    _chirp = AlignedVector<std::complex<float> >(sampleCount);
+    for (unsigned n = 0; n < sampleCount; n++) {
+        unsigned long long n2 = (unsigned long long)n * n % (2ull * sampleCount);
+        double phi = -pi * n2 / sampleCount;
+        _chirp[n] = std::complex<float>(std::cos(phi), std::sin(phi));
+    }
+
+    // Spectrum of the conjugate chirp, wrapped around for negative indices.
+    // The 1/M of the inverse transform is folded in here.
+    _filter = AlignedVector<std::complex<float> >(M);
+    _filter[0] = std::conj(_chirp[0]) / (float)M;
+    for (unsigned n = 1; n < sampleCount; n++) {
+        _filter[n] = _filter[M - n] = std::conj(_chirp[n]) / (float)M;
+    }
+    _fft.transform(_filter.data());
+
+    workspace().resize(0, M);
+}
+
+void BluesteinFft::compute(const float *samples, std::complex<float> *result) {
+    const unsigned N = sampleCount();
+    const unsigned M = _fft.sampleCount();
+    std::complex<float> *buffer = workspace().complex();
+    const float *window = windowCoefficients();
+
+    for (unsigned n = 0; n < N; n++) {
+        buffer[n] = (window ? samples[n] * window[n] : samples[n]) * _chirp[n];
+    }
+    for (unsigned n = N; n < M; n++) {
+        buffer[n] = 0;
+    }
+
+    _fft.transform(buffer);
+
+    // Multiply by the filter, and conjugate so that the forward
+    // transform below computes the inverse one
+    for (unsigned k = 0; k < M; k++) {
+        buffer[k] = std::conj(buffer[k] * _filter[k]);
+    }
+
+    _fft.transform(buffer);
+
+    for (unsigned k = 0; k < N; k++) {
+        result[k] = std::conj(buffer[k]) * _chirp[k];
+    }
+}
@@ -0,0 +1,39 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef BLUESTEINFFT_H
+#define BLUESTEINFFT_H
+
+#include "dft.h"
+#include "radix2fft.h"
+
+// Bluestein's chirp-z algorithm, an O(N log N) DFT of any size.
+// The DFT is rewritten as a convolution with the chirp exp(πjn²/N),
+// which is computed with power of 2 FFTs of at least 2N - 1 values.
+// Used for the sizes MixedRadixFft can't handle, eg. large primes.
+class BluesteinFft final : public Dft {
+private:
+    Radix2Fft _fft;
+    AlignedVector<std::complex<float> > _chirp;
+    AlignedVector<std::complex<float> > _filter;
+
+public:
+    explicit BluesteinFft(unsigned sampleCount);
+
+    using Dft::compute;
+    void compute(const float *samples, std::complex<float> *result);
+};
+
+#endif // BLUESTEINFFT_H
@@ -0,0 +1,256 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include "butterfly.h"
+
+#if defined(SIMD_X86)
+#include <immintrin.h>
+#endif
+
+// The plain C++ passes are written once for both precisions
+template <typename T>
+static void butterflyPassGeneric(std::complex<T> *data, unsigned N, unsigned half, const std::complex<T> *twiddles) {
+    for (unsigned a = 0; a < N; a += half * 2) {
+        for (unsigned b = 0; b < half; b++) {
+            unsigned i = a + b;
+
+            auto u = data[i];
+            auto v = data[i + half] * twiddles[b];
+            data[i] = u + v;
+            data[i + half] = u - v;
+        }
+    }
+}
+
+void butterflyPassScalar(std::complex<float> *data, unsigned N, unsigned half, const std::complex<float> *twiddles) {
+    butterflyPassGeneric(data, N, half, twiddles);
+}
+
+void butterflyPassScalar(std::complex<double> *data, unsigned N, unsigned half, const std::complex<double> *twiddles) {
+    butterflyPassGeneric(data, N, half, twiddles);
+}
+
+void butterflyPass(std::complex<double> *data, unsigned N, unsigned half, const std::complex<double> *twiddles) {
+    butterflyPassGeneric(data, N, half, twiddles);
+}
+
+// The vector passes keep the interleaved layout: one register holds
+// 2, 4 or 8 complex values as (re, im, re, im, ...).
+// For x = (a, b) and w = (c, d): x * w = (ac - bd, bc + ad)
+// = x * (c, c) -/+ (b, a) * (d, d)
+
+#if defined(SIMD_X86)
+
+SIMD_TARGET_SSE2 static inline __m128 multiplySse2(__m128 x, __m128 w) {
+    const __m128 signs = _mm_castsi128_ps(_mm_set_epi32(0, (int)0x80000000, 0, (int)0x80000000));
+    __m128 re = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 0, 0));
+    __m128 im = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 1, 1));
+    __m128 swapped = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_add_ps(_mm_mul_ps(x, re), _mm_xor_ps(_mm_mul_ps(swapped, im), signs));
+}
+
+SIMD_TARGET_SSE2 void butterflyPassSse2(std::complex<float> *data, unsigned N, unsigned half, const std::complex<float> *twiddles) {
+    float *d = reinterpret_cast<float *>(data);
+    const float *t = reinterpret_cast<const float *>(twiddles);
+
+    for (unsigned a = 0; a < N; a += half * 2) {
+        for (unsigned b = 0; b < half; b += 2) {
+            float *pu = d + 2 * (a + b);
+            float *pv = pu + 2 * half;
+
+            __m128 u = _mm_loadu_ps(pu);
+            __m128 v = multiplySse2(_mm_loadu_ps(pv), _mm_loadu_ps(t + 2 * b));
+            _mm_storeu_ps(pu, _mm_add_ps(u, v));
+            _mm_storeu_ps(pv, _mm_sub_ps(u, v));
+        }
+    }
+}
+
+SIMD_TARGET_AVX2 static inline __m256 multiplyAvx2(__m256 x, __m256 w) {
+    __m256 re = _mm256_moveldup_ps(w);
+    __m256 im = _mm256_movehdup_ps(w);
+    __m256 swapped = _mm256_permute_ps(x, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm256_addsub_ps(_mm256_mul_ps(x, re), _mm256_mul_ps(swapped, im));
+}
+
+SIMD_TARGET_AVX2 void butterflyPassAvx2(std::complex<float> *data, unsigned N, unsigned half, const std::complex<float> *twiddles) {
+    float *d = reinterpret_cast<float *>(data);
+    const float *t = reinterpret_cast<const float *>(twiddles);
+
+    for (unsigned a = 0; a < N; a += half * 2) {
+        for (unsigned b = 0; b < half; b += 4) {
+            float *pu = d + 2 * (a + b);
+            float *pv = pu + 2 * half;
+
+            __m256 u = _mm256_loadu_ps(pu);
+            __m256 v = multiplyAvx2(_mm256_loadu_ps(pv), _mm256_loadu_ps(t + 2 * b));
+            _mm256_storeu_ps(pu, _mm256_add_ps(u, v));
+            _mm256_storeu_ps(pv, _mm256_sub_ps(u, v));
+        }
+    }
+}
+
+// The masked shuffles with every lane selected are the plain ones, but GCC
+// warns about the undefined pass-through of the plain ones when the file
+// isn't built with -mavx512f
+SIMD_TARGET_AVX512 static inline __m512 multiplyAvx512(__m512 x, __m512 w) {
+    const __mmask16 all = 0xffff;
+    __m512 re = _mm512_mask_moveldup_ps(w, all, w);
+    __m512 im = _mm512_mask_movehdup_ps(w, all, w);
+    __m512 swapped = _mm512_mask_permute_ps(x, all, x, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm512_fmaddsub_ps(x, re, _mm512_mul_ps(swapped, im));
+}
+
+SIMD_TARGET_AVX512 void butterflyPassAvx512(std::complex<float> *data, unsigned N, unsigned half, const std::complex<float> *twiddles) {
+    float *d = reinterpret_cast<float *>(data);
+    const float *t = reinterpret_cast<const float *>(twiddles);
+
+    for (unsigned a = 0; a < N; a += half * 2) {
+        for (unsigned b = 0; b < half; b += 8) {
+            float *pu = d + 2 * (a + b);
+            float *pv = pu + 2 * half;
+
+            __m512 u = _mm512_loadu_ps(pu);
+            __m512 v = multiplyAvx512(_mm512_loadu_ps(pv), _mm512_loadu_ps(t + 2 * b));
+            _mm512_storeu_ps(pu, _mm512_add_ps(u, v));
+            _mm512_storeu_ps(pv, _mm512_sub_ps(u, v));
+        }
+    }
+}
+
+#endif
+
+void butterflyPass(std::complex<float> *data, unsigned N, unsigned half, const std::complex<float> *twiddles) {
+#if defined(SIMD_X86)
+    static const SimdLevel level = simdLevel();
+    if (level >= SimdLevel::Avx512 && half >= 8) {
+        butterflyPassAvx512(data, N, half, twiddles);
+        return;
+    }
+    if (level >= SimdLevel::Avx2 && half >= 4) {
+        butterflyPassAvx2(data, N, half, twiddles);
+        return;
+    }
+    if (level >= SimdLevel::Sse2 && half >= 2) {
+        butterflyPassSse2(data, N, half, twiddles);
+        return;
+    }
+#endif
+    butterflyPassScalar(data, N, half, twiddles);
+}
+
+template <typename T>
+static void batchButterflyPassGeneric(T *re, T *im, unsigned N, unsigned half, const std::complex<T> *twiddles) {
+    for (unsigned a = 0; a < N; a += half * 2) {
+        for (unsigned b = 0; b < half; b++) {
+            const T wr = twiddles[b].real();
+            const T wi = twiddles[b].imag();
+            T *ur = re + (a + b) * batchLanes;
+            T *ui = im + (a + b) * batchLanes;
+            T *vr = ur + half * batchLanes;
+            T *vi = ui + half * batchLanes;
+
+            for (unsigned l = 0; l < batchLanes; l++) {
+                T tr = vr[l] * wr - vi[l] * wi;
+                T ti = vr[l] * wi + vi[l] * wr;
+                vr[l] = ur[l] - tr;
+                vi[l] = ui[l] - ti;
+                ur[l] += tr;
+                ui[l] += ti;
+            }
+        }
+    }
+}
+
+void batchButterflyPassScalar(float *re, float *im, unsigned N, unsigned half, const std::complex<float> *twiddles) {
+    batchButterflyPassGeneric(re, im, N, half, twiddles);
+}
+
+void batchButterflyPassScalar(double *re, double *im, unsigned N, unsigned half, const std::complex<double> *twiddles) {
+    batchButterflyPassGeneric(re, im, N, half, twiddles);
+}
+
+void batchButterflyPass(double *re, double *im, unsigned N, unsigned half, const std::complex<double> *twiddles) {
+    batchButterflyPassGeneric(re, im, N, half, twiddles);
+}
+
+#if defined(SIMD_X86)
+
+SIMD_TARGET_SSE2 void batchButterflyPassSse2(float *re, float *im, unsigned N, unsigned half, const std::complex<float> *twiddles) {
+    for (unsigned a = 0; a < N; a += half * 2) {
+        for (unsigned b = 0; b < half; b++) {
+            const __m128 wr = _mm_set1_ps(twiddles[b].real());
+            const __m128 wi = _mm_set1_ps(twiddles[b].imag());
+            float *ur = re + (a + b) * batchLanes;
+            float *ui = im + (a + b) * batchLanes;
+            float *vr = ur + half * batchLanes;
+            float *vi = ui + half * batchLanes;
+
+            for (unsigned l = 0; l < batchLanes; l += 4) {
+                __m128 xr = _mm_load_ps(vr + l);
+                __m128 xi = _mm_load_ps(vi + l);
+                __m128 tr = _mm_sub_ps(_mm_mul_ps(xr, wr), _mm_mul_ps(xi, wi));
+                __m128 ti = _mm_add_ps(_mm_mul_ps(xr, wi), _mm_mul_ps(xi, wr));
+                __m128 yr = _mm_load_ps(ur + l);
+                __m128 yi = _mm_load_ps(ui + l);
+                _mm_store_ps(vr + l, _mm_sub_ps(yr, tr));
+                _mm_store_ps(vi + l, _mm_sub_ps(yi, ti));
+                _mm_store_ps(ur + l, _mm_add_ps(yr, tr));
+                _mm_store_ps(ui + l, _mm_add_ps(yi, ti));
+            }
+        }
+    }
+}
+
+SIMD_TARGET_AVX2 void batchButterflyPassAvx2(float *re, float *im, unsigned N, unsigned half, const std::complex<float> *twiddles) {
+    for (unsigned a = 0; a < N; a += half * 2) {
+        for (unsigned b = 0; b < half; b++) {
+            const __m256 wr = _mm256_set1_ps(twiddles[b].real());
+            const __m256 wi = _mm256_set1_ps(twiddles[b].imag());
+            float *ur = re + (a + b) * batchLanes;
+            float *ui = im + (a + b) * batchLanes;
+            float *vr = ur + half * batchLanes;
+            float *vi = ui + half * batchLanes;
+
+            __m256 xr = _mm256_load_ps(vr);
+            __m256 xi = _mm256_load_ps(vi);
+            __m256 tr = _mm256_sub_ps(_mm256_mul_ps(xr, wr), _mm256_mul_ps(xi, wi));
+            __m256 ti = _mm256_add_ps(_mm256_mul_ps(xr, wi), _mm256_mul_ps(xi, wr));
+            __m256 yr = _mm256_load_ps(ur);
+            __m256 yi = _mm256_load_ps(ui);
+            _mm256_store_ps(vr, _mm256_sub_ps(yr, tr));
+            _mm256_store_ps(vi, _mm256_sub_ps(yi, ti));
+            _mm256_store_ps(ur, _mm256_add_ps(yr, tr));
+            _mm256_store_ps(ui, _mm256_add_ps(yi, ti));
+        }
+    }
+}
+
+#endif
+
+void batchButterflyPass(float *re, float *im, unsigned N, unsigned half, const std::complex<float> *twiddles) {
+#if defined(SIMD_X86)
+    static const SimdLevel level = simdLevel();
+    if (level >= SimdLevel::Avx2) {
+        batchButterflyPassAvx2(re, im, N, half, twiddles);
+        return;
+    }
+    if (level >= SimdLevel::Sse2) {
+        batchButterflyPassSse2(re, im, N, half, twiddles);
+        return;
+    }
+#endif
+    batchButterflyPassScalar(re, im, N, half, twiddles);
+}
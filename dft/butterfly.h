@@ -0,0 +1,66 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef BUTTERFLY_H
+#define BUTTERFLY_H
+
+#include <complex>
+#include "cpufeatures.h"
+
+// Radix-2 butterfly passes.
+// One pass combines every pair of DFTs of size 'half' in 'data' (N interleaved
+// complex values) into DFTs of size 2 * half, using the 'half' multipliers
+// in 'twiddles' (see TwiddleTable::stage).
+
+void butterflyPassScalar(std::complex<float> *data, unsigned N, unsigned half, const std::complex<float> *twiddles);
+
+// The SIMD passes are always built on x86, and must only be called when
+// simdLevel() allows them
+#if defined(SIMD_X86)
+// Needs half >= 2
+void butterflyPassSse2(std::complex<float> *data, unsigned N, unsigned half, const std::complex<float> *twiddles);
+// Needs half >= 4
+void butterflyPassAvx2(std::complex<float> *data, unsigned N, unsigned half, const std::complex<float> *twiddles);
+// Needs half >= 8
+void butterflyPassAvx512(std::complex<float> *data, unsigned N, unsigned half, const std::complex<float> *twiddles);
+#endif
+
+// Widest pass simdLevel() allows for this stage, the scalar one for narrow stages
+void butterflyPass(std::complex<float> *data, unsigned N, unsigned half, const std::complex<float> *twiddles);
+
+// Batched passes, for many transforms of the same size at once.
+// The batch is stored split and interleaved across transforms: element i of
+// transform l is re[i * batchLanes + l], im[i * batchLanes + l], so that
+// every lane of a register belongs to a different transform.
+const unsigned batchLanes = 8;
+
+void batchButterflyPassScalar(float *re, float *im, unsigned N, unsigned half, const std::complex<float> *twiddles);
+
+#if defined(SIMD_X86)
+void batchButterflyPassSse2(float *re, float *im, unsigned N, unsigned half, const std::complex<float> *twiddles);
+void batchButterflyPassAvx2(float *re, float *im, unsigned N, unsigned half, const std::complex<float> *twiddles);
+#endif
+
+// Widest batched pass simdLevel() allows
+void batchButterflyPass(float *re, float *im, unsigned N, unsigned half, const std::complex<float> *twiddles);
+
+// Double precision passes, for the double engines. They are plain C++:
+// double engines are for measurements, where precision matters more than speed.
+void butterflyPassScalar(std::complex<double> *data, unsigned N, unsigned half, const std::complex<double> *twiddles);
+void butterflyPass(std::complex<double> *data, unsigned N, unsigned half, const std::complex<double> *twiddles);
+void batchButterflyPassScalar(double *re, double *im, unsigned N, unsigned half, const std::complex<double> *twiddles);
+void batchButterflyPass(double *re, double *im, unsigned N, unsigned half, const std::complex<double> *twiddles);
+
+#endif // BUTTERFLY_H
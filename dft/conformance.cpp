@@ -0,0 +1,397 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "conformance.h"
+#include "fixedpointfft.h"
+#include "goertzelbank.h"
+#include "radix2fft.h"
+#include "slidingdft.h"
+#include "windowtable.h"
+
+const double DftConformance::minimumSnrDb = 100.0;
+const double DftConformance::fixedPointMinimumSnrDb = 65.0;
+const double DftConformance::doubleMinimumSnrDb = 250.0;
+
+const std::vector<DftConformance::Signal> &DftConformance::testSignals() {
+    static const std::vector<Signal> all = { Random, Impulse, MultiTone, FullScale };
+    return all;
+}
+
+const char *DftConformance::name(Signal signal) {
+    switch (signal) {
+    case Random: return "random";
+    case Impulse: return "impulse";
+    case MultiTone: return "multi-tone";
+    case FullScale: return "full-scale";
+    }
+    return "";
+}
+
+const std::vector<DftConformance::Path> &DftConformance::testPaths() {
+    static const std::vector<Path> all = { Interleaved, Split, Batch, Windowed };
+    return all;
+}
+
+const char *DftConformance::name(Path path) {
+    switch (path) {
+    case Interleaved: return "interleaved";
+    case Split: return "split";
+    case Batch: return "batch";
+    case Windowed: return "windowed";
+    }
+    return "";
+}
+
+std::vector<unsigned> DftConformance::testSizes(unsigned minLog2, unsigned maxLog2) {
+    static const unsigned otherSizes[] = { 3, 5, 7, 12, 97, 480, 960, 1009, 1920 };
+    std::vector<unsigned> sizes;
+    for (unsigned log2sc = minLog2; log2sc <= maxLog2; log2sc++) {
+        sizes.push_back(1u << log2sc);
+    }
+    sizes.insert(sizes.end(), std::begin(otherSizes), std::end(otherSizes));
+    return sizes;
+}
+
+std::vector<float> DftConformance::generate(Signal signal, unsigned sampleCount) {
+    const double pi = std::acos(-1.0);
+    std::vector<float> samples(sampleCount);
+    std::mt19937 generator(sampleCount);
+
+    switch (signal) {
+    case Random: {
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        for (float &sample : samples) {
+            sample = distribution(generator);
+        }
+        break;
+    }
+    case Impulse:
+        samples[std::min(1u, sampleCount - 1)] = 1.0f;
+        break;
+    case MultiTone: {
+        const double tones[][3] = {
+            // cycles per frame, amplitude, phase
+            { 1.0, 1.0, 0.0 },
+            { 3.3, 0.5, 1.0 },
+            { sampleCount / 5.7, 0.25, 2.0 },
+            { sampleCount / 2.3, 0.125, 3.0 },
+        };
+        for (unsigned n = 0; n < sampleCount; n++) {
+            double sum = 0;
+            for (const auto &tone : tones) {
+                sum += tone[1] * std::cos(2.0 * pi * tone[0] * n / sampleCount + tone[2]);
+            }
+            samples[n] = (float)sum;
+        }
+        break;
+    }
+    case FullScale: {
+        std::uniform_int_distribution<int> distribution(-32768, 32767);
+        for (float &sample : samples) {
+            sample = (float)distribution(generator);
+        }
+        break;
+    }
+    }
+
+    return samples;
+}
+
+std::vector<std::complex<double> > DftConformance::reference(const std::vector<float> &samples) {
+    const double pi = std::acos(-1.0);
+    const unsigned N = (unsigned)samples.size();
+    std::vector<std::complex<double> > result(N);
+
+    if (N == 0 || (N & (N - 1)) != 0) {
+        // Plain DFT, the angles are exact as nk is taken mod N
+        std::vector<std::complex<double> > roots(N);
+        for (unsigned k = 0; k < N; k++) {
+            roots[k] = std::polar(1.0, -2.0 * pi * k / N);
+        }
+        for (unsigned k = 0; k < N; k++) {
+            std::complex<double> sum = 0;
+            unsigned long long nk = 0;
+            for (unsigned n = 0; n < N; n++) {
+                sum += (double)samples[n] * roots[nk];
+                nk = (nk + k) % N;
+            }
+            result[k] = sum;
+        }
+        return result;
+    }
+
+    // Radix-2 FFT, with every multiplier computed directly
+    unsigned bits = 0;
+    while ((1u << bits) < N) {
+        bits++;
+    }
+    for (unsigned i = 0; i < N; i++) {
+        unsigned r = 0;
+        for (unsigned b = 0; b < bits; b++) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        result[r] = samples[i];
+    }
+    for (unsigned half = 1; half < N; half *= 2) {
+        for (unsigned b = 0; b < half; b++) {
+            std::complex<double> w = std::polar(1.0, -pi * b / half);
+            for (unsigned a = 0; a < N; a += half * 2) {
+                std::complex<double> u = result[a + b];
+                std::complex<double> v = result[a + b + half] * w;
+                result[a + b] = u + v;
+                result[a + b + half] = u - v;
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<int16_t> DftConformance::generateInt16(Signal signal, unsigned sampleCount) {
+    std::vector<float> samples = generate(signal, sampleCount);
+    double peak = 0;
+    for (float sample : samples) {
+        peak = std::max(peak, (double)std::abs(sample));
+    }
+
+    // FullScale already spans the int16 range
+    const double scale = (signal == FullScale || peak == 0) ? 1.0 : 32767.0 / peak;
+    std::vector<int16_t> result(sampleCount);
+    for (unsigned n = 0; n < sampleCount; n++) {
+        long value = std::lround(samples[n] * scale);
+        result[n] = (int16_t)std::min(32767L, std::max(-32768L, value));
+    }
+    return result;
+}
+
+template <typename T>
+static DftConformance::Result compare(const std::vector<std::complex<double> > &expected, const std::vector<std::complex<T> > &actual) {
+    double peak = 0, maxError = 0, signalEnergy = 0, errorEnergy = 0;
+    unsigned bins = std::min((unsigned)actual.size(), (unsigned)expected.size());
+    for (unsigned k = 0; k < bins; k++) {
+        double error = std::abs(expected[k] - std::complex<double>(actual[k]));
+        peak = std::max(peak, std::abs(expected[k]));
+        maxError = std::max(maxError, error);
+        signalEnergy += std::norm(expected[k]);
+        errorEnergy += error * error;
+    }
+
+    // Keep the numbers finite for exact results
+    const double tiny = 1e-300;
+    DftConformance::Result result;
+    result.maxErrorDb = 20.0 * std::log10(std::max(maxError, tiny) / std::max(peak, tiny));
+    result.rmsErrorDb = 20.0 * std::log10(std::max(std::sqrt(errorEnergy / std::max(bins, 1u)), tiny) / std::max(peak, tiny));
+    result.snrDb = 10.0 * std::log10(std::max(signalEnergy, tiny) / std::max(errorEnergy, tiny));
+    return result;
+}
+
+// Only the bins the engine returns are compared
+static void append(std::vector<std::complex<double> > &expected, const std::vector<std::complex<double> > &bins, unsigned binCount) {
+    expected.insert(expected.end(), bins.begin(), bins.begin() + binCount);
+}
+
+DftConformance::Result DftConformance::check(Dft *engine, Signal signal, Path path) {
+    const unsigned N = engine->sampleCount();
+    const unsigned bins = engine->binCount();
+    std::vector<float> samples = generate(signal, N);
+    std::vector<std::complex<double> > expected;
+    std::vector<std::complex<float> > actual;
+
+    switch (path) {
+    case Interleaved:
+        append(expected, reference(samples), bins);
+        actual = engine->compute(samples);
+        break;
+    case Split: {
+        append(expected, reference(samples), bins);
+        std::vector<float> real(bins), imag(bins);
+        engine->computeSplit(samples.data(), real.data(), imag.data());
+        for (unsigned k = 0; k < bins; k++) {
+            actual.push_back(std::complex<float>(real[k], imag[k]));
+        }
+        break;
+    }
+    case Batch: {
+        std::vector<std::vector<float> > frames(batchFrames, samples);
+        std::vector<std::vector<std::complex<float> > > results(batchFrames, std::vector<std::complex<float> >(bins));
+        std::vector<const float *> framePointers;
+        std::vector<std::complex<float> *> resultPointers;
+        for (unsigned f = 0; f < batchFrames; f++) {
+            std::rotate(frames[f].begin(), frames[f].begin() + f % N, frames[f].end());
+            append(expected, reference(frames[f]), bins);
+            framePointers.push_back(frames[f].data());
+            resultPointers.push_back(results[f].data());
+        }
+        engine->computeBatch(framePointers.data(), resultPointers.data(), batchFrames);
+        for (const auto &result : results) {
+            actual.insert(actual.end(), result.begin(), result.end());
+        }
+        break;
+    }
+    case Windowed: {
+        std::shared_ptr<const WindowTable> window = WindowTable::forSize(WindowType::BlackmanHarris, N);
+        std::vector<float> windowed(N);
+        for (unsigned n = 0; n < N; n++) {
+            windowed[n] = samples[n] * window->coefficients()[n];
+        }
+        append(expected, reference(windowed), bins);
+
+        std::shared_ptr<const WindowTable> previous = engine->window();
+        engine->setWindow(window);
+        actual = engine->compute(samples);
+        engine->setWindow(previous);
+        break;
+    }
+    }
+
+    return compare(expected, actual);
+}
+
+DftConformance::Result DftConformance::checkInt16(FixedPointFft *engine, Signal signal, bool split) {
+    std::vector<int16_t> samples = generateInt16(signal, engine->sampleCount());
+    std::vector<std::complex<double> > expected = reference(std::vector<float>(samples.begin(), samples.end()));
+
+    std::vector<std::complex<float> > actual(engine->binCount());
+    if (split) {
+        std::vector<float> real(engine->binCount()), imag(engine->binCount());
+        engine->computeSplit(samples.data(), real.data(), imag.data());
+        for (unsigned k = 0; k < engine->binCount(); k++) {
+            actual[k] = std::complex<float>(real[k], imag[k]);
+        }
+    }
+    else {
+        engine->compute(samples.data(), actual.data());
+    }
+    return compare(expected, actual);
+}
+
+DftConformance::Result DftConformance::check(BasicDft<double> *engine, Signal signal) {
+    std::vector<float> samples = generate(signal, engine->sampleCount());
+    return compare(reference(samples), engine->compute(std::vector<double>(samples.begin(), samples.end())));
+}
+
+DftConformance::Result DftConformance::checkSliding(unsigned sampleCount, Signal signal) {
+    // The frame repeated with a different gain each time, so that the last
+    // sampleCount samples aren't a frame that was already seen
+    std::vector<float> frame = generate(signal, sampleCount);
+    std::vector<float> stream(sampleCount * 5 / 2 + 1);
+    for (unsigned n = 0; n < stream.size(); n++) {
+        stream[n] = frame[n % sampleCount] * float(1 + n / sampleCount);
+    }
+
+    // Every hop slides, whatever the SIMD level: only the periodic resync
+    // recomputes the bins with an FFT
+    SlidingDft sliding(sampleCount, 0, sampleCount);
+    std::vector<std::complex<float> > actual(sliding.binCount());
+    unsigned position = 0;
+    for (unsigned step = 0; position < stream.size(); step++) {
+        unsigned hop = std::min(1 + step * 37 % 200, unsigned(stream.size()) - position);
+        sliding.push(stream.data() + position, hop);
+        sliding.spectrum(actual.data());
+        position += hop;
+    }
+
+    std::vector<float> last(stream.end() - sampleCount, stream.end());
+    std::vector<std::complex<double> > expected;
+    append(expected, reference(last), sliding.binCount());
+    return compare(expected, actual);
+}
+
+DftConformance::Result DftConformance::checkGoertzel(unsigned sampleCount, Signal signal) {
+    // Sampled at sampleCount Hz, the filter at k Hz over sampleCount samples is bin k
+    GoertzelBank bank((float)sampleCount);
+    std::vector<unsigned> bins;
+    for (unsigned k : { 1u, 2u, 3u, sampleCount / 7, sampleCount / 3, sampleCount / 2 - 1 }) {
+        if (std::find(bins.begin(), bins.end(), k) == bins.end()) {
+            bins.push_back(k);
+            bank.add(float(k), sampleCount);
+        }
+    }
+
+    std::vector<float> samples = generate(signal, sampleCount);
+    bank.push(samples.data(), sampleCount);
+
+    // Goertzel only gives the magnitudes
+    std::vector<std::complex<double> > spectrum = reference(samples);
+    std::vector<std::complex<double> > expected;
+    std::vector<std::complex<float> > actual;
+    for (unsigned i = 0; i < bins.size(); i++) {
+        expected.push_back(std::abs(spectrum[bins[i]]));
+        actual.push_back(bank.magnitude(i));
+    }
+    return compare(expected, actual);
+}
+
+bool DftConformance::run(const std::vector<DftFactory::Engine> &engines, const std::vector<unsigned> &sizes, bool others,
+                         const std::function<void(const Case &)> &report) {
+    bool ok = true;
+    auto add = [&](const char *engine, unsigned size, Signal signal, const char *path, const Result &result, double minimum) {
+        Case c = { engine, size, signal, path, result, minimum, result.snrDb >= minimum };
+        ok = ok && c.passed;
+        report(c);
+    };
+
+    for (DftFactory::Engine engine : engines) {
+        const double minimum = (engine == DftFactory::Engine::FixedPoint) ? fixedPointMinimumSnrDb : minimumSnrDb;
+        for (unsigned sampleCount : sizes) {
+            if (engine == DftFactory::Engine::Trivial && sampleCount > maxSlowSize) {
+                continue;
+            }
+            Dft *dft = DftFactory::create(sampleCount, engine);
+            if (!dft) {
+                continue;
+            }
+
+            for (Signal signal : testSignals()) {
+                for (Path path : testPaths()) {
+                    add(DftFactory::name(engine), sampleCount, signal, name(path), check(dft, signal, path), minimum);
+                }
+                if (engine == DftFactory::Engine::FixedPoint) {
+                    FixedPointFft *fixedPoint = static_cast<FixedPointFft *>(dft);
+                    add(DftFactory::name(engine), sampleCount, signal, "int16", checkInt16(fixedPoint, signal, false), minimum);
+                    add(DftFactory::name(engine), sampleCount, signal, "int16 split", checkInt16(fixedPoint, signal, true), minimum);
+                }
+            }
+            delete dft;
+        }
+    }
+
+    if (!others) {
+        return ok;
+    }
+
+    for (unsigned sampleCount : sizes) {
+        bool powerOf2 = (sampleCount & (sampleCount - 1)) == 0;
+        for (Signal signal : testSignals()) {
+            if (sampleCount <= maxSlowSize) {
+                BasicTrivialDft<double> trivial(sampleCount);
+                add("trivial-double", sampleCount, signal, "interleaved", check(&trivial, signal), doubleMinimumSnrDb);
+            }
+            if (powerOf2) {
+                BasicRadix2Fft<double> radix2(sampleCount);
+                add("radix2-double", sampleCount, signal, "interleaved", check(&radix2, signal), doubleMinimumSnrDb);
+            }
+            if (sampleCount <= maxSlowSize) {
+                add("sliding", sampleCount, signal, "interleaved", checkSliding(sampleCount, signal), minimumSnrDb);
+            }
+            if (sampleCount >= 8) {
+                add("goertzel", sampleCount, signal, "interleaved", checkGoertzel(sampleCount, signal), minimumSnrDb);
+            }
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,135 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef CONFORMANCE_H
+#define CONFORMANCE_H
+
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "dft.h"
+#include "dftfactory.h"
+
+class FixedPointFft;
+
+// Accuracy checks of the DFT engines against a double precision reference.
+// Errors are given in dB relative to the largest bin of the reference spectrum.
+class DftConformance {
+public:
+    enum Signal {
+        // Uniform noise in [-1, 1]
+        Random,
+        // A single 1 at index 1, flat spectrum with a phase ramp
+        Impulse,
+        // A few cosines with off-bin frequencies and different phases
+        MultiTone,
+        // Noise spanning the whole int16 range, like the capture path
+        FullScale
+    };
+
+    // Entry point of the engine that is checked
+    enum Path {
+        // compute()
+        Interleaved,
+        // computeSplit()
+        Split,
+        // computeBatch() on batchFrames shifted copies of the signal
+        Batch,
+        // compute() with a Blackman-Harris window set, against the
+        // reference of the windowed samples
+        Windowed
+    };
+
+    // Frames of a Batch check: more than the lanes of the batched engines,
+    // and not a multiple of them, so that their tail runs too
+    static const unsigned batchFrames = 11;
+
+    struct Result {
+        double maxErrorDb;
+        double rmsErrorDb;
+        double snrDb;
+    };
+
+    static const std::vector<Signal> &testSignals();
+    static const char *name(Signal signal);
+    static const std::vector<Path> &testPaths();
+    static const char *name(Path path);
+
+    // Powers of 2 from 2^minLog2 to 2^maxLog2, then a few other sizes:
+    // small primes, products of 2, 3, 5, 7 (48 kHz periods) and larger
+    // primes for Bluestein
+    static std::vector<unsigned> testSizes(unsigned minLog2, unsigned maxLog2);
+
+    static std::vector<float> generate(Signal signal, unsigned sampleCount);
+    // The same signal scaled to the whole int16 range, like a capture frame
+    static std::vector<int16_t> generateInt16(Signal signal, unsigned sampleCount);
+
+    // DFT of the samples computed in double precision
+    static std::vector<std::complex<double> > reference(const std::vector<float> &samples);
+
+    static Result check(Dft *engine, Signal signal, Path path = Interleaved);
+    // The int16 capture path of FixedPointFft, through compute() or, when
+    // split is true, computeSplit(). The reference is the DFT of the int16 samples.
+    static Result checkInt16(FixedPointFft *engine, Signal signal, bool split);
+    // The double precision engines, through compute()
+    static Result check(BasicDft<double> *engine, Signal signal);
+
+    // SlidingDft fed with two and a half frames of the signal, in hops of
+    // 1 to 200 samples with the spectrum read after each, so that it goes
+    // through resyncs, sliding updates and FFT updates. Its last spectrum
+    // is compared with the reference of the last sampleCount samples.
+    static Result checkSliding(unsigned sampleCount, Signal signal);
+    // GoertzelBank filters tuned to a few bins of a sampleCount DFT, with
+    // blocks of sampleCount samples: their magnitudes are compared with
+    // those of the reference bins. Needs sampleCount >= 8.
+    static Result checkGoertzel(unsigned sampleCount, Signal signal);
+
+    // Smallest acceptable SNR of single precision engines.
+    // They reach 120-140 dB, anything below this is a bug.
+    static const double minimumSnrDb;
+
+    // Same for FixedPointFft, whose Q15 twiddles limit it to 70-90 dB
+    // (75 dB for noise at 2^12, 70 dB at 2^20)
+    static const double fixedPointMinimumSnrDb;
+
+    // Same for the double precision engines, which reach 270-300 dB
+    static const double doubleMinimumSnrDb;
+
+    // One check of run()
+    struct Case {
+        std::string engine;
+        unsigned size;
+        Signal signal;
+        std::string path;
+        Result result;
+        double minimumSnrDb;
+        bool passed;
+    };
+
+    // Checks every path of the engines at every size they support, plus the
+    // int16 path of FixedPointFft. With others, also checks the double
+    // engines, SlidingDft and GoertzelBank (up to maxSlowSize for the
+    // O(N²) ones). Calls report for each check and returns whether they
+    // all passed.
+    static bool run(const std::vector<DftFactory::Engine> &engines, const std::vector<unsigned> &sizes, bool others,
+                    const std::function<void(const Case &)> &report);
+
+    // The plain DFT and the sliding DFT check are O(N²), larger sizes would take minutes
+    static const unsigned maxSlowSize = 1u << 12;
+};
+
+#endif // CONFORMANCE_H
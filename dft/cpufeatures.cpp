@@ -0,0 +1,165 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "cpufeatures.h"
+
+#if defined(SIMD_X86) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#elif defined(SIMD_X86)
+#include <cpuid.h>
+#endif
+
+static const char *const levelNames[] = { "scalar", "sse2", "avx2", "avx512" };
+
+static SimdLevel detect() {
+#if defined(SIMD_X86) && defined(__GNUC__)
+    // libgcc also checks that the OS saves the wide registers (XGETBV)
+    __builtin_cpu_init();
+    const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    // The AVX-512 level also runs the AVX2 kernels, on the stages too narrow for a zmm register
+    if (avx2 && __builtin_cpu_supports("avx512f")) {
+        return SimdLevel::Avx512;
+    }
+    if (avx2) {
+        return SimdLevel::Avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SimdLevel::Sse2;
+    }
+    return SimdLevel::Scalar;
+#elif defined(SIMD_X86)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] >> 26) & 1;
+    const bool fma = (info[2] >> 12) & 1;
+    const bool osxsave = (info[2] >> 27) & 1;
+    if (!sse2) {
+        return SimdLevel::Scalar;
+    }
+    if (!osxsave || maxLeaf < 7) {
+        return SimdLevel::Sse2;
+    }
+
+    // XMM and YMM state (bits 1, 2), then opmask and ZMM state (bits 5 to 7)
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] >> 5) & 1;
+    const bool avx512 = (info[1] >> 16) & 1;
+    if (avx2 && avx512 && fma && (xcr0 & 0xe6) == 0xe6) {
+        return SimdLevel::Avx512;
+    }
+    if (avx2 && fma && (xcr0 & 0x6) == 0x6) {
+        return SimdLevel::Avx2;
+    }
+    return SimdLevel::Sse2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel detectedSimdLevel() {
+    static const SimdLevel level = detect();
+    return level;
+}
+
+static SimdLevel select() {
+    const SimdLevel detected = detectedSimdLevel();
+    const char *forced = std::getenv("FA_SIMD_LEVEL");
+    if (!forced || !*forced) {
+        return detected;
+    }
+
+    for (int i = 0; i <= int(SimdLevel::Avx512); i++) {
+        if (std::strcmp(forced, levelNames[i]) == 0) {
+            if (SimdLevel(i) > detected) {
+                std::cout << "FA_SIMD_LEVEL=" << forced << " is not supported by this CPU, using " << simdLevelName(detected) << std::endl;
+                return detected;
+            }
+            return SimdLevel(i);
+        }
+    }
+
+    std::cout << "FA_SIMD_LEVEL should be scalar, sse2, avx2 or avx512, but it's " << forced << std::endl;
+    return detected;
+}
+
+SimdLevel simdLevel() {
+    static const SimdLevel level = select();
+    return level;
+}
+
+const char *simdLevelName(SimdLevel level) {
+    return levelNames[int(level)];
+}
+
+static std::string trimmed(const std::string &text) {
+    const char *blanks = " \t";
+    size_t first = text.find_first_not_of(blanks);
+    if (first == std::string::npos) {
+        return std::string();
+    }
+    return text.substr(first, text.find_last_not_of(blanks) - first + 1);
+}
+
+static std::string detectName() {
+#if defined(SIMD_X86)
+    // Leaves 0x80000002 to 0x80000004 hold the 48-byte brand string
+    unsigned brand[12] = { 0 };
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, int(0x80000000));
+    if (unsigned(info[0]) >= 0x80000004) {
+        for (unsigned i = 0; i < 3; i++) {
+            __cpuid(reinterpret_cast<int *>(brand + 4 * i), int(0x80000002 + i));
+        }
+    }
+#else
+    if (__get_cpuid_max(0x80000000, nullptr) >= 0x80000004) {
+        for (unsigned i = 0; i < 3; i++) {
+            __get_cpuid(0x80000002 + i, brand + 4 * i, brand + 4 * i + 1, brand + 4 * i + 2, brand + 4 * i + 3);
+        }
+    }
+#endif
+    std::string name = trimmed(std::string(reinterpret_cast<const char *>(brand), strnlen(reinterpret_cast<const char *>(brand), sizeof(brand))));
+    if (!name.empty()) {
+        return name;
+    }
+#endif
+
+    // "model name : ..." on x86 and most ARM kernels
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 10, "model name") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                return trimmed(line.substr(colon + 1));
+            }
+        }
+    }
+    return std::string();
+}
+
+const std::string &cpuName() {
+    static const std::string name = detectName();
+    return name;
+}
@@ -0,0 +1,60 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+
+#include <string>
+
+// SIMD instruction sets of the numeric kernels.
+// Every variant is compiled into the same binary, each function with the
+// target attribute of its instruction set, so the build needs no special
+// flags. The kernels pick the widest variant the CPU supports at runtime.
+enum class SimdLevel {
+    Scalar,
+    Sse2,
+    Avx2,
+    Avx512
+};
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SIMD_X86
+#define SIMD_TARGET_SSE2 __attribute__((target("sse2")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#elif defined(_M_X64) || defined(_M_IX86)
+// MSVC compiles every intrinsic without flags
+#define SIMD_X86
+#define SIMD_TARGET_SSE2
+#define SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX512
+#endif
+
+// Widest level supported by the CPU and enabled by the OS, detected once
+SimdLevel detectedSimdLevel();
+
+// Level the kernels use: the detected one, unless the FA_SIMD_LEVEL
+// environment variable (scalar, sse2, avx2 or avx512) asks for a lower one.
+// Read once, the first time a kernel runs.
+SimdLevel simdLevel();
+
+// Short stable name, as in FA_SIMD_LEVEL
+const char *simdLevelName(SimdLevel level);
+
+// Model name of the CPU, from CPUID on x86 and from /proc/cpuinfo
+// elsewhere, empty when neither has it. Read once.
+const std::string &cpuName();
+
+#endif // CPUFEATURES_H
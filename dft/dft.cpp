@@ -14,52 +14,129 @@
 // Copyright (c) 2014 Timur Kristóf
 
 #include "dft.h"
+#include "twiddletable.h"
+#include "windowtable.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <random>
 #include <QElapsedTimer>
 #include <QDebug>
 
-float Dft::benchmark(Dft *reference, Dft *benchmarked, unsigned sampleCount) {
-    std::vector<float> samples(sampleCount);
-    for (unsigned i = 0; i < sampleCount; i++) {
-        samples[i] = (float)rand();
+template <typename T>
+std::vector<std::complex<T> > BasicDft<T>::compute(const std::vector<T> &samples) {
+    // Check input size
+    if (samples.size() < _sampleCount) {
+        std::cout << "sample count is: " << samples.size() << ", expected: " << _sampleCount << std::endl;
+        throw std::exception();
+    }
+
+    std::vector<std::complex<T> > result(_binCount);
+    compute(samples.data(), result.data());
+    return result;
+}
+
+template <typename T>
+void BasicDft<T>::computeBatch(const T *const *frames, std::complex<T> *const *results, unsigned count) {
+    for (unsigned i = 0; i < count; i++) {
+        compute(frames[i], results[i]);
+    }
+}
+
+template <typename T>
+void BasicDft<T>::computeSplit(const T *samples, T *real, T *imag) {
+    // Allocated on the first call only, most engines never see one
+    if (_interleaved.empty()) {
+        _interleaved.resize(_binCount);
+    }
+    compute(samples, _interleaved.data());
+    deinterleave(_interleaved.data(), real, imag, _binCount);
+}
+
+template <typename T>
+void BasicDft<T>::setWindow(std::shared_ptr<const BasicWindowTable<T> > window) {
+    if (window && window->size() != _sampleCount) {
+        std::cout << "window size is: " << window->size() << ", expected: " << _sampleCount << std::endl;
+        throw std::exception();
+    }
+
+    _window = window;
+    _windowCoefficients = window ? window->coefficients() : nullptr;
+}
+
+template <typename T>
+typename BasicDft<T>::Timing BasicDft<T>::measure(BasicDft *engine, unsigned runs, double minRunNs, double warmupNs) {
+    const unsigned N = engine->sampleCount();
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<T> distribution(-1, 1);
+    AlignedVector<T> samples(N);
+    for (unsigned i = 0; i < N; i++) {
+        samples[i] = distribution(generator);
     }
+    AlignedVector<std::complex<T> > result(engine->binCount());
 
-    float referenceTime, benchmarkedTime;
     QElapsedTimer timer;
 
+    // Warm up caches, branch predictors and clocks, and find out how many
+    // calls make a run long enough for the timer
+    unsigned calls = 0;
     timer.start();
-    reference->compute(samples);
-    referenceTime = (float)timer.elapsed();
+    do {
+        engine->compute(samples.data(), result.data());
+        calls++;
+    } while (timer.nsecsElapsed() < warmupNs);
+
+    double perCall = (double)timer.nsecsElapsed() / calls;
+    unsigned callsPerRun = std::max(1u, (unsigned)std::ceil(minRunNs / std::max(perCall, 1.0)));
+
+    std::vector<double> times(std::max(1u, runs));
+    for (double &time : times) {
+        timer.start();
+        for (unsigned c = 0; c < callsPerRun; c++) {
+            engine->compute(samples.data(), result.data());
+        }
+        time = (double)timer.nsecsElapsed() / callsPerRun;
+    }
 
-    timer.start();
-    benchmarked->compute(samples);
-    benchmarkedTime = (float)timer.elapsed();
+    std::sort(times.begin(), times.end());
+    Timing timing;
+    timing.minNs = times.front();
+    timing.medianNs = times[times.size() / 2];
+    timing.p99Ns = times[std::min(times.size() - 1, (size_t)std::ceil(0.99 * times.size()) - 1)];
+    timing.callsPerRun = callsPerRun;
+    timing.runs = (unsigned)times.size();
+    return timing;
+}
 
-    timer.invalidate();
-    return benchmarkedTime / referenceTime;
+template <typename T>
+float BasicDft<T>::benchmark(BasicDft *reference, BasicDft *benchmarked) {
+    return (float)(measure(benchmarked).medianNs / measure(reference).medianNs);
 }
 
-bool Dft::test(Dft *reference, Dft *impl, unsigned sampleCount) {
-    std::vector<float> samples = generateSineSamples(sampleCount);
+template <typename T>
+bool BasicDft<T>::test(BasicDft *reference, BasicDft *impl, unsigned sampleCount) {
+    std::vector<T> samples = generateSineSamples(sampleCount);
 
     bool ok = true;
     auto r1 = reference->compute(samples);
     auto r2 = impl->compute(samples);
 
-    float diff, allowed;
+    // Real-input engines only return the non-redundant half of the spectrum
+    unsigned bins = (unsigned)std::min(r1.size(), r2.size());
 
-    for (unsigned i = 0; i < sampleCount; i++) {
-        diff = std::abs(std::abs(r1[i]) - std::abs(r2[i]));
-        allowed = std::abs(r1[i]) * 0.1 + 0.01;
-        if (diff > allowed) {
-            std::cout << "problem with amplitude at index " << i << " ref: " << std::abs(r1[i]) << "; got: " << std::abs(r2[i]) << std::endl;
-            ok = false;
-        }
+    // Compare the complex values relative to the largest bin (-80 dB).
+    // Amplitudes and phases can't be checked on their own: the phase of
+    // a bin that only holds rounding noise is meaningless, and it wraps at ±π.
+    T peak = 0;
+    for (unsigned i = 0; i < bins; i++) {
+        peak = std::max(peak, std::abs(r1[i]));
+    }
+    const T allowed = peak * T(1e-4) + T(1e-6);
 
-        diff = std::abs(std::arg(r1[i]) - std::arg(r2[i]));
-        allowed = std::abs(std::arg(r1[i])) * 0.1 + 0.01;
+    for (unsigned i = 0; i < bins; i++) {
+        T diff = std::abs(r1[i] - r2[i]);
         if (diff > allowed) {
-            std::cout << "problem with phase at index " << i << " ref: " << std::arg(r1[i]) << "; got: " << std::arg(r2[i]) << std::endl;
+            std::cout << "problem at index " << i << " ref: " << r1[i] << "; got: " << r2[i] << std::endl;
             ok = false;
         }
     }
@@ -67,10 +144,11 @@ bool Dft::test(Dft *reference, Dft *impl, unsigned sampleCount) {
     return ok;
 }
 
-std::vector<float> Dft::generateSineSamples(unsigned n, float a, float f) {
-    const float pi = std::acos(-1);
-    float om = 2 * pi * f / n;
-    std::vector<float> samples(n);
+template <typename T>
+std::vector<T> BasicDft<T>::generateSineSamples(unsigned n, T a, T f) {
+    const T pi = std::acos(T(-1));
+    T om = 2 * pi * f / n;
+    std::vector<T> samples(n);
     for (unsigned i = 0; i < n; i++) {
         samples[i] = a * std::cos(om * i);
     }
@@ -78,32 +156,36 @@ std::vector<float> Dft::generateSineSamples(unsigned n, float a, float f) {
     return samples;
 }
 
-TrivialDft::TrivialDft(unsigned sampleCount) : Dft(sampleCount) {
+template <typename T>
+BasicTrivialDft<T>::BasicTrivialDft(unsigned sampleCount) : BasicDft<T>(sampleCount) {
+    _twiddles = BasicTwiddleTable<T>::forSize(sampleCount);
 }
 
-std::vector<std::complex<float> > TrivialDft::compute(const std::vector<float> &samples) {
-    unsigned N = sampleCount();
-    if (samples.size() < N) {
-        std::cout << "sample count " << samples.size() << ", expected: " << N;
-        throw std::exception();
-    }
-
-    const float pi = std::acos(-1);
-    const std::complex<float> j(0, 1);
-    const std::complex<float> aa = -j * 2.0f * pi / (float)N;
+template <typename T>
+void BasicTrivialDft<T>::compute(const T *samples, std::complex<T> *result) {
+    unsigned N = this->sampleCount();
+    const T *window = this->windowCoefficients();
+    const std::complex<T> *roots = _twiddles->roots();
 
-    std::vector<std::complex<float> > result(N);
     for (unsigned n = 0; n < N; n++) {
-        std::complex<float> bb = aa * (float)n;
+        result[n] = 0;
 
+        // exp(-2πjnk/N) only depends on nk mod N
+        unsigned nk = 0;
         for (unsigned k = 0; k < N; k++) {
-            result[n] += samples[k] * std::exp(bb * (float)k);
+            result[n] += (window ? samples[k] * window[k] : samples[k]) * roots[nk];
+            nk += n;
+            if (nk >= N) {
+                nk -= N;
+            }
         }
     }
-
-    return result;
 }
 
+template class BasicDft<float>;
+template class BasicDft<double>;
+template class BasicTrivialDft<float>;
+template class BasicTrivialDft<double>;
 
 /*
  * Many implementations of the DFT are possible.
@@ -116,6 +198,8 @@ std::vector<std::complex<float> > TrivialDft::compute(const std::vector<float> &
 
 #include "dft/dft.h"
 #include "dft/radix2fft.h"
+#include "dft/radix4fft.h"
+#include "dft/realfft.h"
 
 int main() {
     // Generate sine samples
@@ -148,11 +232,37 @@ int main() {
     }
 
     // Test an implementation numerically
+    // (DftConformance checks every engine much more thoroughly, see fft-benchmark --check)
     bool ok = Dft::test(&dft, &fft, n);
     std::cout << "tested implementation " << (ok ? "is ok" :  "sucks") << std::endl;
 
+    // The plain C++ butterflies are checked the same way...
+    Radix2Fft scalarFft(n, Radix2Fft::Scalar);
+    ok = Dft::test(&dft, &scalarFft, n);
+    std::cout << "scalar radix 2 implementation " << (ok ? "is ok" :  "sucks") << std::endl;
+
+    // ...and then serve as the reference for the SIMD ones
+    // (run with FA_SIMD_LEVEL=sse2 or avx2 to check a narrower level than the CPU's)
+    ok = Dft::test(&scalarFft, &fft, n);
+    std::cout << "SIMD radix 2 implementation " << (ok ? "is ok" :  "sucks") << std::endl;
+
+    // So is the radix-4 engine
+    Radix4Fft fft4(n);
+    ok = Dft::test(&dft, &fft4, n);
+    std::cout << "radix 4 implementation " << (ok ? "is ok" :  "sucks") << std::endl;
+
+    // The real-input FFT only returns the bins up to n/2, the test compares those
+    RealFft rfft(n);
+    ok = Dft::test(&dft, &rfft, n);
+    std::cout << "real-input implementation " << (ok ? "is ok" :  "sucks") << std::endl;
+
+    // The same engines exist in double precision, for long measurements
+    BasicRadix2Fft<double> fftd(n);
+    std::vector<double> samplesd(samples.begin(), samples.end());
+    std::vector<std::complex<double> > resultd = fftd.compute(samplesd);
+
     // Benchmark an implementation (for execution time)
-    float r = Dft::benchmark(&dft, &fft, n);
+    float r = Dft::benchmark(&dft, &fft);
     std::cout << "tested implementation's execution time is " << r << "× of the reference" << std::endl;
 
     return 0;
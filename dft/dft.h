@@ -17,33 +17,144 @@
 #define DFT_H
 
 #include <complex>
+#include <memory>
 #include <vector>
+#include "alignedallocator.h"
+#include "splitspectrum.h"
 
-class Dft {
+template <typename T> class BasicTwiddleTable;
+template <typename T> class BasicWindowTable;
+
+// The engines are templates on the sample type: T is float for the live
+// display, double for long measurement sessions. Both are instantiated
+// explicitly in the .cpp files; Dft, TrivialDft... are the float ones.
+
+// Scratch memory of an engine.
+// Engines size it once when they are created, so that computing a frame
+// never has to allocate.
+template <typename T>
+class BasicDftWorkspace {
+private:
+    AlignedVector<T> _real;
+    AlignedVector<std::complex<T> > _complex;
+
+public:
+    inline void resize(unsigned realCount, unsigned complexCount) {
+        _real.resize(realCount);
+        _complex.resize(complexCount);
+    }
+
+    inline T *real() {
+        return _real.data();
+    }
+
+    inline std::complex<T> *complex() {
+        return _complex.data();
+    }
+};
+
+template <typename T>
+class BasicDft {
 private:
     unsigned _sampleCount;
+    unsigned _binCount;
     double _samplingFrequency;
+    BasicDftWorkspace<T> _workspace;
+    AlignedVector<std::complex<T> > _interleaved;
+    std::shared_ptr<const BasicWindowTable<T> > _window;
+    const T *_windowCoefficients;
+
+protected:
+    inline BasicDftWorkspace<T> &workspace() {
+        return _workspace;
+    }
+
+    // sampleCount() window coefficients, nullptr without a window.
+    // Engines multiply the samples by them in the pass that loads them.
+    inline const T *windowCoefficients() {
+        return _windowCoefficients;
+    }
 
 public:
-    explicit inline Dft(unsigned sampleCount) : _sampleCount(sampleCount) { }
-    virtual std::vector<std::complex<float> > compute(const std::vector<float> &samples) = 0;
+    typedef T Sample;
+    typedef std::complex<T> Bin;
+
+    explicit inline BasicDft(unsigned sampleCount) : _sampleCount(sampleCount), _binCount(sampleCount), _windowCoefficients(nullptr) { }
+    inline BasicDft(unsigned sampleCount, unsigned binCount) : _sampleCount(sampleCount), _binCount(binCount), _windowCoefficients(nullptr) { }
+    virtual ~BasicDft() { }
+
+    // Computes the spectrum of sampleCount() samples into binCount() bins
+    // provided by the caller. Doesn't allocate anything.
+    virtual void compute(const T *samples, std::complex<T> *result) = 0;
+
+    // Convenience wrapper that checks the input size and allocates the result
+    std::vector<std::complex<T> > compute(const std::vector<T> &samples);
+
+    // Computes 'count' frames of sampleCount() samples at once,
+    // frames[i] into the binCount() bins of results[i].
+    // Engines that can share work across frames override this,
+    // the default just computes them one by one.
+    virtual void computeBatch(const T *const *frames, std::complex<T> *const *results, unsigned count);
+
+    // Same spectrum as compute(), written as binCount() real parts and
+    // binCount() imaginary parts (see BasicSplitSpectrum).
+    // Engines that can write this layout directly override it, the default
+    // computes the interleaved bins and splits them.
+    virtual void computeSplit(const T *samples, T *real, T *imag);
 
     inline unsigned sampleCount() {
         return _sampleCount;
     }
 
-    static float benchmark(Dft *reference, Dft *benchmarked, unsigned sampleCount = 4096);
+    // Window applied to the samples by every compute call, of sampleCount()
+    // coefficients, nullptr for none (the default)
+    virtual void setWindow(std::shared_ptr<const BasicWindowTable<T> > window);
+    inline const std::shared_ptr<const BasicWindowTable<T> > &window() {
+        return _window;
+    }
 
-    static bool test(Dft *reference, Dft *impl, unsigned sampleCount = 4096);
+    // Number of bins returned: sampleCount(), or only the non-redundant
+    // sampleCount() / 2 + 1 for engines specialized for real input
+    inline unsigned binCount() {
+        return _binCount;
+    }
 
-    static std::vector<float> generateSineSamples(unsigned n = 1024, float amplitude = 100, float f = 1);
+    // Execution time of one compute() call, measured with nanosecond resolution
+    struct Timing {
+        double minNs;
+        double medianNs;
+        double p99Ns;
+        // compute() calls per timed run, so that a run is long enough to measure
+        unsigned callsPerRun;
+        unsigned runs;
+    };
+
+    // Times the engine on random samples, after a warmup
+    static Timing measure(BasicDft *engine, unsigned runs = 101, double minRunNs = 20000, double warmupNs = 2000000);
+
+    // Median execution time of 'benchmarked' relative to 'reference',
+    // both at their own sampleCount()
+    static float benchmark(BasicDft *reference, BasicDft *benchmarked);
+
+    static bool test(BasicDft *reference, BasicDft *impl, unsigned sampleCount = 4096);
+
+    static std::vector<T> generateSineSamples(unsigned n = 1024, T amplitude = 100, T f = 1);
 };
 
-class TrivialDft final : public Dft {
+template <typename T>
+class BasicTrivialDft final : public BasicDft<T> {
+private:
+    std::shared_ptr<const BasicTwiddleTable<T> > _twiddles;
+
 public:
-    explicit TrivialDft(unsigned sampleCount);
+    explicit BasicTrivialDft(unsigned sampleCount);
 
-    std::vector<std::complex<float> > compute(const std::vector<float> &samples);
+    using BasicDft<T>::compute;
+    void compute(const T *samples, std::complex<T> *result);
 };
 
+typedef BasicDftWorkspace<float> DftWorkspace;
+typedef BasicDft<float> Dft;
+typedef BasicTrivialDft<float> TrivialDft;
+
 #endif // DFT_H
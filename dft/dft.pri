@@ -0,0 +1,75 @@
+# DFT engines and the bundled ffft library, shared by the application and the benchmark
+
+INCLUDEPATH += $$PWD/..
+
+HEADERS += \
+    $$PWD/dft.h \
+    $$PWD/splitspectrum.h \
+    $$PWD/twiddletable.h \
+    $$PWD/windowtable.h \
+    $$PWD/alignedallocator.h \
+    $$PWD/cpufeatures.h \
+    $$PWD/butterfly.h \
+    $$PWD/bitreversal.h \
+    $$PWD/radix2fft.h \
+    $$PWD/radix4fft.h \
+    $$PWD/stockhamfft.h \
+    $$PWD/realfft.h \
+    $$PWD/fixedlenfft.h \
+    $$PWD/fixedpointfft.h \
+    $$PWD/mixedradixfft.h \
+    $$PWD/bluesteinfft.h \
+    $$PWD/sixstepfft.h \
+    $$PWD/slidingdft.h \
+    $$PWD/goertzelbank.h \
+    $$PWD/magnitude.h \
+    $$PWD/sampleconversion.h \
+    $$PWD/overlapsave.h \
+    $$PWD/dftfactory.h \
+    $$PWD/dfthandle.h \
+    $$PWD/dftplanner.h \
+    $$PWD/conformance.h \
+    $$PWD/../ffft/Array.h \
+    $$PWD/../ffft/Array.hpp \
+    $$PWD/../ffft/def.h \
+    $$PWD/../ffft/DynArray.h \
+    $$PWD/../ffft/DynArray.hpp \
+    $$PWD/../ffft/FFTReal.h \
+    $$PWD/../ffft/FFTReal.hpp \
+    $$PWD/../ffft/FFTRealFixLen.h \
+    $$PWD/../ffft/FFTRealFixLen.hpp \
+    $$PWD/../ffft/FFTRealFixLenParam.h \
+    $$PWD/../ffft/FFTRealPassDirect.h \
+    $$PWD/../ffft/FFTRealPassDirect.hpp \
+    $$PWD/../ffft/FFTRealPassInverse.h \
+    $$PWD/../ffft/FFTRealPassInverse.hpp \
+    $$PWD/../ffft/FFTRealSelect.h \
+    $$PWD/../ffft/FFTRealSelect.hpp \
+    $$PWD/../ffft/FFTRealUseTrigo.h \
+    $$PWD/../ffft/FFTRealUseTrigo.hpp \
+    $$PWD/../ffft/OscSinCos.h \
+    $$PWD/../ffft/OscSinCos.hpp
+
+SOURCES += \
+    $$PWD/dft.cpp \
+    $$PWD/twiddletable.cpp \
+    $$PWD/windowtable.cpp \
+    $$PWD/cpufeatures.cpp \
+    $$PWD/butterfly.cpp \
+    $$PWD/radix2fft.cpp \
+    $$PWD/radix4fft.cpp \
+    $$PWD/stockhamfft.cpp \
+    $$PWD/realfft.cpp \
+    $$PWD/fixedlenfft.cpp \
+    $$PWD/fixedpointfft.cpp \
+    $$PWD/mixedradixfft.cpp \
+    $$PWD/bluesteinfft.cpp \
+    $$PWD/sixstepfft.cpp \
+    $$PWD/slidingdft.cpp \
+    $$PWD/goertzelbank.cpp \
+    $$PWD/magnitude.cpp \
+    $$PWD/sampleconversion.cpp \
+    $$PWD/overlapsave.cpp \
+    $$PWD/dftfactory.cpp \
+    $$PWD/dftplanner.cpp \
+    $$PWD/conformance.cpp
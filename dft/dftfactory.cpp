@@ -0,0 +1,180 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <cstring>
+#include "dftfactory.h"
+#include "bluesteinfft.h"
+#include "fixedlenfft.h"
+#include "fixedpointfft.h"
+#include "mixedradixfft.h"
+#include "radix2fft.h"
+#include "radix4fft.h"
+#include "realfft.h"
+#include "sixstepfft.h"
+#include "stockhamfft.h"
+
+template <int LL2>
+static Dft *createFixedLen() {
+    return new FixedLenFft<LL2>();
+}
+
+static const int minFixedLenLog2 = 8;
+static const int maxFixedLenLog2 = 16;
+static const int minSixStepLog2 = 20;
+
+// Indexed by log2(sampleCount) - minFixedLenLog2
+static Dft *(*const fixedLenFactories[])() = {
+    &createFixedLen<8>,
+    &createFixedLen<9>,
+    &createFixedLen<10>,
+    &createFixedLen<11>,
+    &createFixedLen<12>,
+    &createFixedLen<13>,
+    &createFixedLen<14>,
+    &createFixedLen<15>,
+    &createFixedLen<16>,
+};
+
+static bool isPowerOf2(unsigned sampleCount) {
+    return sampleCount != 0 && (sampleCount & (sampleCount - 1)) == 0;
+}
+
+static int log2Of(unsigned sampleCount) {
+    int log2sc = 0;
+    while ((1u << log2sc) < sampleCount) {
+        log2sc++;
+    }
+    return log2sc;
+}
+
+static const struct {
+    DftFactory::Engine engine;
+    const char *name;
+} engineNames[] = {
+    { DftFactory::Engine::Automatic, "automatic" },
+    { DftFactory::Engine::Trivial, "trivial" },
+    { DftFactory::Engine::Radix2, "radix2" },
+    { DftFactory::Engine::Radix2Scalar, "radix2-scalar" },
+    { DftFactory::Engine::Radix4, "radix4" },
+    { DftFactory::Engine::Stockham, "stockham" },
+    { DftFactory::Engine::Real, "real" },
+    { DftFactory::Engine::FixedLength, "fixed-length" },
+    { DftFactory::Engine::MixedRadix, "mixed-radix" },
+    { DftFactory::Engine::Bluestein, "bluestein" },
+    { DftFactory::Engine::SixStep, "six-step" },
+    { DftFactory::Engine::FixedPoint, "fixed-point" },
+};
+
+Dft *DftFactory::create(unsigned sampleCount) {
+    if (sampleCount == 0) {
+        return new TrivialDft(sampleCount);
+    }
+
+    if (!isPowerOf2(sampleCount)) {
+        if (MixedRadixFft::supports(sampleCount)) {
+            return new MixedRadixFft(sampleCount);
+        }
+        return new BluesteinFft(sampleCount);
+    }
+
+    int log2sc = log2Of(sampleCount);
+
+    if (log2sc >= minFixedLenLog2 && log2sc <= maxFixedLenLog2) {
+        return fixedLenFactories[log2sc - minFixedLenLog2]();
+    }
+
+    if (log2sc >= minSixStepLog2 && QThread::idealThreadCount() > 1) {
+        return new SixStepFft(sampleCount);
+    }
+
+    return new RealFft(sampleCount);
+}
+
+Dft *DftFactory::create(unsigned sampleCount, Engine engine) {
+    if (!supports(engine, sampleCount)) {
+        return nullptr;
+    }
+
+    switch (engine) {
+    case Engine::Automatic: return create(sampleCount);
+    case Engine::Trivial: return new TrivialDft(sampleCount);
+    case Engine::Radix2: return new Radix2Fft(sampleCount);
+    case Engine::Radix2Scalar: return new Radix2Fft(sampleCount, Radix2Fft::Scalar);
+    case Engine::Radix4: return new Radix4Fft(sampleCount);
+    case Engine::Stockham: return new StockhamFft(sampleCount);
+    case Engine::Real: return new RealFft(sampleCount);
+    case Engine::FixedLength: return fixedLenFactories[log2Of(sampleCount) - minFixedLenLog2]();
+    case Engine::MixedRadix: return new MixedRadixFft(sampleCount);
+    case Engine::Bluestein: return new BluesteinFft(sampleCount);
+    case Engine::SixStep: return new SixStepFft(sampleCount);
+    case Engine::FixedPoint: return new FixedPointFft(sampleCount);
+    }
+
+    return nullptr;
+}
+
+bool DftFactory::supports(Engine engine, unsigned sampleCount) {
+    switch (engine) {
+    case Engine::Automatic:
+    case Engine::Trivial:
+        return true;
+    case Engine::Radix2:
+    case Engine::Radix2Scalar:
+    case Engine::Radix4:
+    case Engine::Stockham:
+    case Engine::Real:
+        return isPowerOf2(sampleCount);
+    case Engine::FixedLength:
+        return isPowerOf2(sampleCount) && log2Of(sampleCount) >= minFixedLenLog2 && log2Of(sampleCount) <= maxFixedLenLog2;
+    case Engine::MixedRadix:
+        return sampleCount != 0 && MixedRadixFft::supports(sampleCount);
+    case Engine::Bluestein:
+        return sampleCount != 0;
+    case Engine::SixStep:
+        return isPowerOf2(sampleCount) && sampleCount >= 4;
+    case Engine::FixedPoint:
+        return isPowerOf2(sampleCount) && sampleCount >= 2;
+    }
+
+    return false;
+}
+
+std::vector<DftFactory::Engine> DftFactory::engines() {
+    std::vector<Engine> result;
+    for (const auto &entry : engineNames) {
+        if (entry.engine != Engine::Automatic) {
+            result.push_back(entry.engine);
+        }
+    }
+    return result;
+}
+
+const char *DftFactory::name(Engine engine) {
+    for (const auto &entry : engineNames) {
+        if (entry.engine == engine) {
+            return entry.name;
+        }
+    }
+    return "";
+}
+
+DftFactory::Engine DftFactory::engineByName(const char *name) {
+    for (const auto &entry : engineNames) {
+        if (std::strcmp(entry.name, name) == 0) {
+            return entry.engine;
+        }
+    }
+    return Engine::Automatic;
+}
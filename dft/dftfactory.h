@@ -0,0 +1,61 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef DFTFACTORY_H
+#define DFTFACTORY_H
+
+#include <vector>
+#include "dft.h"
+
+class DftFactory {
+public:
+    enum class Engine {
+        Automatic,
+        Trivial,
+        Radix2,
+        Radix2Scalar,
+        Radix4,
+        Stockham,
+        Real,
+        FixedLength,
+        MixedRadix,
+        Bluestein,
+        SixStep,
+        // Less accurate (~75 dB SNR): never picked automatically
+        FixedPoint
+    };
+
+    // Creates the fastest engine available for the given size:
+    // a fixed-length FFT for 2^8 ... 2^16, the multithreaded six-step FFT
+    // from 2^20 on multicore machines, the generic real FFT for other
+    // powers of 2, the mixed radix FFT for products of 2, 3, 5, 7
+    // and Bluestein's algorithm for everything else.
+    // The caller owns the returned engine.
+    static Dft *create(unsigned sampleCount);
+
+    // Creates the given engine, or returns nullptr if it doesn't support the size
+    static Dft *create(unsigned sampleCount, Engine engine);
+
+    static bool supports(Engine engine, unsigned sampleCount);
+
+    // Every engine except Automatic
+    static std::vector<Engine> engines();
+
+    // Short stable name, used in benchmark reports and wisdom files
+    static const char *name(Engine engine);
+    static Engine engineByName(const char *name);
+};
+
+#endif // DFTFACTORY_H
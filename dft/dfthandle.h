@@ -0,0 +1,130 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef DFTHANDLE_H
+#define DFTHANDLE_H
+
+#include <memory>
+#include <utility>
+#include <variant>
+#include "dft.h"
+#include "bluesteinfft.h"
+#include "fixedlenfft.h"
+#include "fixedpointfft.h"
+#include "mixedradixfft.h"
+#include "radix2fft.h"
+#include "radix4fft.h"
+#include "realfft.h"
+#include "sixstepfft.h"
+#include "stockhamfft.h"
+
+// Owns an engine and remembers its concrete type, so that the per-frame
+// calls are statically dispatched: compute() and visit() call the final
+// class directly instead of going through the Dft vtable. The engine is
+// still chosen at runtime (DftFactory, DftPlanner), only once.
+// visit() lets the caller write its post-processing once, as a generic
+// lambda that gets instantiated for every engine type.
+class DftHandle {
+public:
+    typedef std::variant<
+        std::unique_ptr<RealFft>,
+        std::unique_ptr<FixedLenFft<8> >,
+        std::unique_ptr<FixedLenFft<9> >,
+        std::unique_ptr<FixedLenFft<10> >,
+        std::unique_ptr<FixedLenFft<11> >,
+        std::unique_ptr<FixedLenFft<12> >,
+        std::unique_ptr<FixedLenFft<13> >,
+        std::unique_ptr<FixedLenFft<14> >,
+        std::unique_ptr<FixedLenFft<15> >,
+        std::unique_ptr<FixedLenFft<16> >,
+        std::unique_ptr<Radix2Fft>,
+        std::unique_ptr<Radix4Fft>,
+        std::unique_ptr<StockhamFft>,
+        std::unique_ptr<MixedRadixFft>,
+        std::unique_ptr<BluesteinFft>,
+        std::unique_ptr<SixStepFft>,
+        std::unique_ptr<FixedPointFft>,
+        std::unique_ptr<TrivialDft>,
+        // Any other engine, through the vtable
+        std::unique_ptr<Dft>
+    > Engine;
+
+private:
+    Engine _engine;
+    Dft *_dft;
+
+    template <std::size_t I = 0>
+    static Engine adopt(Dft *dft) {
+        typedef typename std::variant_alternative<I, Engine>::type::element_type Type;
+        if constexpr (I + 1 == std::variant_size<Engine>::value) {
+            return Engine(std::in_place_index<I>, dft);
+        }
+        else {
+            if (Type *engine = dynamic_cast<Type *>(dft)) {
+                return Engine(std::in_place_index<I>, engine);
+            }
+            return adopt<I + 1>(dft);
+        }
+    }
+
+public:
+    inline DftHandle() : _engine(std::in_place_index<std::variant_size<Engine>::value - 1>), _dft(nullptr) { }
+
+    // Takes ownership of an engine made by DftFactory or DftPlanner
+    explicit inline DftHandle(Dft *dft) : _engine(adopt(dft)), _dft(dft) { }
+
+    DftHandle(DftHandle &&) = default;
+    DftHandle &operator=(DftHandle &&) = default;
+
+    explicit inline operator bool() {
+        return _dft != nullptr;
+    }
+
+    // The engine through its base class, for everything but the hot path
+    inline Dft *get() {
+        return _dft;
+    }
+
+    inline unsigned sampleCount() {
+        return _dft->sampleCount();
+    }
+
+    inline unsigned binCount() {
+        return _dft->binCount();
+    }
+
+    // The engine if it is an E, nullptr otherwise
+    template <typename E>
+    inline E *getIf() {
+        std::unique_ptr<E> *engine = std::get_if<std::unique_ptr<E> >(&_engine);
+        return engine ? engine->get() : nullptr;
+    }
+
+    // Calls f(engine) with the engine as its concrete type
+    template <typename F>
+    inline decltype(auto) visit(F &&f) {
+        return std::visit([&](auto &engine) -> decltype(auto) { return f(*engine); }, _engine);
+    }
+
+    inline void compute(const float *samples, std::complex<float> *result) {
+        visit([&](auto &engine) { engine.compute(samples, result); });
+    }
+
+    inline void computeSplit(const float *samples, float *real, float *imag) {
+        visit([&](auto &engine) { engine.computeSplit(samples, real, imag); });
+    }
+};
+
+#endif // DFTHANDLE_H
@@ -0,0 +1,162 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <iostream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QThread>
+#include "dftplanner.h"
+#include "cpufeatures.h"
+
+// The plain DFT is O(N²) and can only win for tiny sizes
+static const unsigned maxTrivialSize = 256;
+
+// Fewer runs than the benchmark: the planner runs when the analyzer starts
+static const unsigned plannerRuns = 21;
+static const double plannerWarmupNs = 1000000;
+
+// Wisdom measured on another machine or build is worthless
+static QJsonObject machine() {
+    QJsonObject result;
+    result["cpu_architecture"] = QSysInfo::currentCpuArchitecture();
+    // Same architecture and thread count, but not the same timings
+    result["cpu_name"] = QString::fromStdString(cpuName());
+    result["build_abi"] = QSysInfo::buildAbi();
+    result["thread_count"] = QThread::idealThreadCount();
+    // The SIMD kernels are picked at runtime, FA_SIMD_LEVEL changes the timings
+    result["simd_level"] = simdLevelName(simdLevel());
+    return result;
+}
+
+DftPlanner::DftPlanner(const QString &wisdomPath)
+    : _wisdomPath(wisdomPath) {
+    loadWisdom();
+}
+
+DftFactory::Engine DftPlanner::plan(unsigned sampleCount) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = _plans.find(sampleCount);
+        if (found != _plans.end()) {
+            return found->second;
+        }
+    }
+
+    DftFactory::Engine best = DftFactory::Engine::Automatic;
+    double bestNs = 0;
+
+    for (DftFactory::Engine engine : DftFactory::engines()) {
+        if (engine == DftFactory::Engine::Trivial && sampleCount > maxTrivialSize) {
+            continue;
+        }
+        // Fast on some CPUs, but not as accurate as the others: only on request
+        if (engine == DftFactory::Engine::FixedPoint) {
+            continue;
+        }
+
+        Dft *dft = DftFactory::create(sampleCount, engine);
+        if (!dft) {
+            continue;
+        }
+
+        double ns = Dft::measure(dft, plannerRuns, 20000, plannerWarmupNs).medianNs;
+        if (best == DftFactory::Engine::Automatic || ns < bestNs) {
+            best = engine;
+            bestNs = ns;
+        }
+        delete dft;
+    }
+
+    std::cout << "DftPlanner: " << DftFactory::name(best) << " is the fastest for " << sampleCount << " samples (" << bestNs << " ns)" << std::endl;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _plans[sampleCount] = best;
+    saveWisdom();
+    return best;
+}
+
+bool DftPlanner::planned(unsigned sampleCount) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _plans.count(sampleCount) != 0;
+}
+
+Dft *DftPlanner::create(unsigned sampleCount) {
+    return DftFactory::create(sampleCount, plan(sampleCount));
+}
+
+void DftPlanner::forget() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _plans.clear();
+    if (!_wisdomPath.isEmpty()) {
+        QFile::remove(_wisdomPath);
+    }
+}
+
+void DftPlanner::loadWisdom() {
+    if (_wisdomPath.isEmpty()) {
+        return;
+    }
+
+    QFile file(_wisdomPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QJsonObject wisdom = QJsonDocument::fromJson(file.readAll()).object();
+    if (wisdom["machine"].toObject() != machine()) {
+        std::cout << "DftPlanner: the wisdom was measured on another machine, ignoring it" << std::endl;
+        return;
+    }
+
+    QJsonObject plans = wisdom["plans"].toObject();
+    for (auto i = plans.begin(); i != plans.end(); ++i) {
+        bool ok;
+        unsigned sampleCount = i.key().toUInt(&ok);
+        QByteArray name = i.value().toString().toLatin1();
+        DftFactory::Engine engine = DftFactory::engineByName(name.constData());
+
+        // Sizes or engines this build doesn't know are measured again
+        if (ok && engine != DftFactory::Engine::Automatic && DftFactory::supports(engine, sampleCount)) {
+            _plans[sampleCount] = engine;
+        }
+    }
+}
+
+void DftPlanner::saveWisdom() {
+    if (_wisdomPath.isEmpty()) {
+        return;
+    }
+
+    QJsonObject plans;
+    for (const auto &entry : _plans) {
+        plans[QString::number(entry.first)] = DftFactory::name(entry.second);
+    }
+
+    QJsonObject wisdom;
+    wisdom["machine"] = machine();
+    wisdom["plans"] = plans;
+
+    QDir().mkpath(QFileInfo(_wisdomPath).absolutePath());
+    QFile file(_wisdomPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::cout << "DftPlanner: can't write " << file.fileName().toStdString() << std::endl;
+        return;
+    }
+    file.write(QJsonDocument(wisdom).toJson(QJsonDocument::Indented));
+}
@@ -0,0 +1,59 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef DFTPLANNER_H
+#define DFTPLANNER_H
+
+#include <map>
+#include <mutex>
+#include <QString>
+#include "dftfactory.h"
+
+// Picks the fastest engine for a size by timing every candidate on this
+// machine, the first time the size is asked for. The choices are kept in a
+// JSON wisdom file so that later launches don't have to measure again.
+// The wisdom is dropped when the CPU, the build or the thread count changes.
+// Measuring takes a while: it can run on a worker thread, the planner is
+// safe to use from several threads.
+class DftPlanner {
+private:
+    QString _wisdomPath;
+    // Guards _plans and the wisdom file, not the measurements
+    std::mutex _mutex;
+    std::map<unsigned, DftFactory::Engine> _plans;
+
+    void loadWisdom();
+    void saveWisdom();
+
+public:
+    // An empty path keeps the wisdom in memory only
+    explicit DftPlanner(const QString &wisdomPath = QString());
+
+    // Returns the fastest engine for the size, measuring it on the calling thread if needed
+    DftFactory::Engine plan(unsigned sampleCount);
+
+    // Whether plan() already knows the size, from a measurement or the wisdom file
+    bool planned(unsigned sampleCount);
+
+    // Creates the fastest engine for the size. The caller owns it.
+    Dft *create(unsigned sampleCount);
+
+    QString wisdomPath() { return _wisdomPath; }
+
+    // Forgets every plan and deletes the wisdom file
+    void forget();
+};
+
+#endif // DFTPLANNER_H
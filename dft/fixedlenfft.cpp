@@ -0,0 +1,39 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include "fixedlenfft.h"
+#include "realfft.h"
+
+template <int LL2>
+FixedLenFft<LL2>::FixedLenFft() : Dft(1u << LL2, (1u << LL2) / 2 + 1) {
+    workspace().resize(1u << LL2, 0);
+}
+
+template <int LL2>
+void FixedLenFft<LL2>::compute(const float *samples, std::complex<float> *result) {
+    float *packed = workspace().real();
+    _fft.do_fft(packed, samples, windowCoefficients());
+    RealFft::unpack(packed, sampleCount(), result);
+}
+
+template class FixedLenFft<8>;
+template class FixedLenFft<9>;
+template class FixedLenFft<10>;
+template class FixedLenFft<11>;
+template class FixedLenFft<12>;
+template class FixedLenFft<13>;
+template class FixedLenFft<14>;
+template class FixedLenFft<15>;
+template class FixedLenFft<16>;
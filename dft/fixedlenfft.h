@@ -0,0 +1,47 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef FIXEDLENFFT_H
+#define FIXEDLENFFT_H
+
+#include "dft.h"
+#include "ffft/FFTRealFixLen.h"
+
+// Real-input FFT of length 2^LL2, based on ffft::FFTRealFixLen.
+// The whole transform is unrolled at compile time, so only the lengths
+// instantiated in fixedlenfft.cpp are available, see DftFactory.
+template <int LL2>
+class FixedLenFft final : public Dft {
+private:
+    ffft::FFTRealFixLen<LL2> _fft;
+
+public:
+    FixedLenFft();
+
+    using Dft::compute;
+    void compute(const float *samples, std::complex<float> *result);
+};
+
+extern template class FixedLenFft<8>;
+extern template class FixedLenFft<9>;
+extern template class FixedLenFft<10>;
+extern template class FixedLenFft<11>;
+extern template class FixedLenFft<12>;
+extern template class FixedLenFft<13>;
+extern template class FixedLenFft<14>;
+extern template class FixedLenFft<15>;
+extern template class FixedLenFft<16>;
+
+#endif // FIXEDLENFFT_H
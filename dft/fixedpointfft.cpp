@@ -0,0 +1,220 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "fixedpointfft.h"
+#include "windowtable.h"
+
+// A butterfly output is at most (1 + sqrt(2)) times the largest input
+// component, this keeps it below 2^30
+static const int32_t maxSafeComponent = 444000000;
+
+// Samples are loaded with their peak below 2^28, which leaves room for
+// the first butterflies and 13 or more bits below the int16 precision
+static const int loadBits = 28;
+
+FixedPointFft::FixedPointFft(unsigned sampleCount) : Dft(sampleCount, sampleCount / 2 + 1), _reversal(0) {
+    if (sampleCount < 2 || (sampleCount & (sampleCount - 1)) != 0) {
+        std::cout << "sample count should be a power of 2, but it's " << sampleCount << std::endl;
+        throw std::exception();
+    }
+
+    _log2sc = 0;
+    while ((1u << _log2sc) < sampleCount) {
+        _log2sc++;
+    }
+
+    _reversal = BitReversal(_log2sc);
+
+    const double pi = std::acos(-1.0);
+    _twiddles.resize(sampleCount);
+    for (unsigned k = 0; k < sampleCount / 2; k++) {
+        double phase = -2.0 * pi * k / sampleCount;
+        _twiddles[2 * k] = int16_t(std::lround(32767.0 * std::cos(phase)));
+        _twiddles[2 * k + 1] = int16_t(std::lround(32767.0 * std::sin(phase)));
+    }
+
+    _data.resize(2 * sampleCount);
+}
+
+void FixedPointFft::setWindow(std::shared_ptr<const BasicWindowTable<float> > window) {
+    Dft::setWindow(window);
+
+    _windowQ15.clear();
+    if (window) {
+        const float *coefficients = window->coefficients();
+        _windowQ15.resize(sampleCount());
+        for (unsigned i = 0; i < sampleCount(); i++) {
+            _windowQ15[i] = int16_t(std::lround(32767.0f * coefficients[i]));
+        }
+    }
+}
+
+int FixedPointFft::load(const float *samples) {
+    unsigned N = sampleCount();
+    const float *window = windowCoefficients();
+    auto sample = [&](unsigned i) { return window ? samples[i] * window[i] : samples[i]; };
+
+    float peak = 0.0f;
+    for (unsigned i = 0; i < N; i++) {
+        peak = std::max(peak, std::fabs(sample(i)));
+    }
+
+    // peak < 2^p, so samples * 2^(loadBits - p) are below 2^loadBits
+    int p = 0;
+    if (peak > 0.0f) {
+        std::frexp(peak, &p);
+    }
+    const float scale = std::ldexp(1.0f, loadBits - p);
+
+    _reversal.forEach([&](unsigned i, unsigned j) {
+        float value = sample(i) * scale;
+        int32_t *d = &_data[2 * j];
+        d[0] = int32_t(value + (value < 0.0f ? -0.5f : 0.5f));
+        d[1] = 0;
+    });
+
+    return loadBits - p;
+}
+
+int FixedPointFft::load(const int16_t *samples) {
+    // int16 is below 2^15, shifting it left by loadBits - 15 keeps it below 2^loadBits
+    const int shift = loadBits - 15;
+    if (!_windowQ15.empty()) {
+        // Times the Q15 window it's below 2^30, 2 bits less is the same scale as the shift
+        const int16_t *window = _windowQ15.data();
+        _reversal.forEach([&](unsigned i, unsigned j) {
+            int32_t *d = &_data[2 * j];
+            d[0] = (int32_t(samples[i]) * window[i] + (1 << (15 - shift - 1))) >> (15 - shift);
+            d[1] = 0;
+        });
+        return shift;
+    }
+    _reversal.forEach([&](unsigned i, unsigned j) {
+        int32_t *d = &_data[2 * j];
+        d[0] = int32_t(samples[i]) * (1 << shift);
+        d[1] = 0;
+    });
+
+    return shift;
+}
+
+void FixedPointFft::compute(const float *samples, std::complex<float> *result) {
+    int exponent = load(samples);
+    output(butterflies(1u << loadBits) - exponent, result);
+}
+
+void FixedPointFft::computeSplit(const float *samples, float *real, float *imag) {
+    int exponent = load(samples);
+    output(butterflies(1u << loadBits) - exponent, real, imag);
+}
+
+void FixedPointFft::compute(const int16_t *samples, std::complex<float> *result) {
+    int exponent = load(samples);
+    output(butterflies(1u << loadBits) - exponent, result);
+}
+
+void FixedPointFft::computeSplit(const int16_t *samples, float *real, float *imag) {
+    int exponent = load(samples);
+    output(butterflies(1u << loadBits) - exponent, real, imag);
+}
+
+// Bound of |x| that is cheap to merge: or-ing these gives at most twice the peak
+static inline uint32_t magnitudeBits(int32_t x) {
+    return uint32_t(x ^ (x >> 31));
+}
+
+int FixedPointFft::butterflies(uint32_t peak) {
+    unsigned N = sampleCount();
+    int32_t *data = _data.data();
+    int exponent = 0;
+
+    for (unsigned half = 1; half < N; half *= 2) {
+        // Block floating point: shift the whole frame when this stage could overflow
+        int shift = 0;
+        while ((peak >> shift) >= uint32_t(maxSafeComponent)) {
+            shift++;
+        }
+        const int32_t rounding = shift ? (1 << (shift - 1)) : 0;
+        exponent += shift;
+        peak = 0;
+
+        if (half == 1) {
+            // The twiddle is 1, no multiplication
+            for (unsigned a = 0; a < N; a += 2) {
+                int32_t *u = data + 2 * a;
+                int32_t ur = (u[0] + rounding) >> shift;
+                int32_t ui = (u[1] + rounding) >> shift;
+                int32_t vr = (u[2] + rounding) >> shift;
+                int32_t vi = (u[3] + rounding) >> shift;
+                u[0] = ur + vr;
+                u[1] = ui + vi;
+                u[2] = ur - vr;
+                u[3] = ui - vi;
+                peak |= magnitudeBits(u[0]) | magnitudeBits(u[1]) | magnitudeBits(u[2]) | magnitudeBits(u[3]);
+            }
+            continue;
+        }
+
+        // Twiddle b of this stage is W_N^(b N / (2 half))
+        const unsigned stride = N / (2 * half);
+
+        for (unsigned a = 0; a < N; a += half * 2) {
+            for (unsigned b = 0; b < half; b++) {
+                int32_t *u = data + 2 * (a + b);
+                int32_t *v = u + 2 * half;
+                const int16_t *w = &_twiddles[2 * b * stride];
+
+                int32_t ur = (u[0] + rounding) >> shift;
+                int32_t ui = (u[1] + rounding) >> shift;
+                int32_t vr = (v[0] + rounding) >> shift;
+                int32_t vi = (v[1] + rounding) >> shift;
+
+                // Q15 twiddles: the products are rounded back by 15 bits
+                int32_t tr = int32_t((int64_t(vr) * w[0] - int64_t(vi) * w[1] + (1 << 14)) >> 15);
+                int32_t ti = int32_t((int64_t(vr) * w[1] + int64_t(vi) * w[0] + (1 << 14)) >> 15);
+
+                u[0] = ur + tr;
+                u[1] = ui + ti;
+                v[0] = ur - tr;
+                v[1] = ui - ti;
+
+                // Peak of this stage, for the next one
+                peak |= magnitudeBits(u[0]) | magnitudeBits(u[1]) | magnitudeBits(v[0]) | magnitudeBits(v[1]);
+            }
+        }
+    }
+
+    return exponent;
+}
+
+void FixedPointFft::output(int exponent, std::complex<float> *result) {
+    const float scale = std::ldexp(1.0f, exponent);
+    const int32_t *data = _data.data();
+    for (unsigned k = 0; k < binCount(); k++) {
+        result[k] = std::complex<float>(float(data[2 * k]) * scale, float(data[2 * k + 1]) * scale);
+    }
+}
+
+void FixedPointFft::output(int exponent, float *real, float *imag) {
+    const float scale = std::ldexp(1.0f, exponent);
+    const int32_t *data = _data.data();
+    for (unsigned k = 0; k < binCount(); k++) {
+        real[k] = float(data[2 * k]) * scale;
+        imag[k] = float(data[2 * k + 1]) * scale;
+    }
+}
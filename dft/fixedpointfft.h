@@ -0,0 +1,69 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef FIXEDPOINTFFT_H
+#define FIXEDPOINTFFT_H
+
+#include <cstdint>
+#include "dft.h"
+#include "bitreversal.h"
+
+// Radix-2 FFT in fixed point, for CPUs where integer arithmetic is much
+// cheaper than float (small ARM boards).
+// Samples are int16, twiddles are Q15 and the frame is int32, with a block
+// floating point exponent shared by the whole frame: before every stage,
+// the frame is shifted right just enough that the butterflies can't
+// overflow, and the exponent is increased.
+// The Q15 twiddles limit the precision to about 80-90 dB of SNR, instead of
+// the 130 dB of the float engines (DftConformance::fixedPointMinimumSnrDb).
+// Like the real FFT engines, only the N/2 + 1 non-redundant bins are returned.
+class FixedPointFft final : public Dft {
+private:
+    unsigned _log2sc;
+    BitReversal _reversal;
+    // e^(-2 pi i k / N) in Q15, interleaved (re, im), for k < N/2
+    AlignedVector<int16_t> _twiddles;
+    // Interleaved (re, im) frame being transformed
+    AlignedVector<int32_t> _data;
+    // The window in Q15 for the int16 load, empty without a window
+    AlignedVector<int16_t> _windowQ15;
+
+    // peak bounds the loaded components. Returns the block exponent added
+    // by the stages: value = _data * 2^(exponent - load exponent)
+    int butterflies(uint32_t peak);
+    // Load the samples in bit-reversed order and windowed, and return their load exponent
+    int load(const float *samples);
+    int load(const int16_t *samples);
+    void output(int exponent, std::complex<float> *result);
+    void output(int exponent, float *real, float *imag);
+
+public:
+    explicit FixedPointFft(unsigned sampleCount);
+
+    // Also keeps a Q15 copy of the window, so that int16 frames stay in integers
+    void setWindow(std::shared_ptr<const BasicWindowTable<float> > window);
+
+    using Dft::compute;
+    using Dft::computeSplit;
+    // Float samples are scaled to Q15 with a block exponent of their own
+    void compute(const float *samples, std::complex<float> *result);
+    void computeSplit(const float *samples, float *real, float *imag);
+
+    // The int16 capture path: the samples are used as they are, no float conversion
+    void compute(const int16_t *samples, std::complex<float> *result);
+    void computeSplit(const int16_t *samples, float *real, float *imag);
+};
+
+#endif // FIXEDPOINTFFT_H
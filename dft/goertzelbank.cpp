@@ -0,0 +1,88 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "goertzelbank.h"
+
+GoertzelBank::GoertzelBank(float samplingFrequency) : _samplingFrequency(samplingFrequency) {
+}
+
+void GoertzelBank::add(float frequency, unsigned blockLength) {
+    if (frequency <= 0.0f || frequency >= _samplingFrequency / 2.0f) {
+        std::cout << "Goertzel frequency should be between 0 and " << _samplingFrequency / 2.0f << ", but it's " << frequency << std::endl;
+        throw std::exception();
+    }
+
+    Filter filter;
+    filter.frequency = frequency;
+    filter.blockLength = blockLength ? blockLength : wholePeriods(frequency, 4096);
+
+    // The recurrence is computed in double: in float, low frequencies over
+    // long blocks lose most of their precision (the coefficient is close to 2)
+    const double pi = std::acos(-1.0);
+    double omega = 2.0 * pi * frequency / _samplingFrequency;
+    filter.cosine = std::cos(omega);
+    filter.sine = std::sin(omega);
+    filter.coefficient = 2.0 * filter.cosine;
+    filter.s1 = filter.s2 = 0.0;
+    filter.count = 0;
+    filter.magnitude = 0.0f;
+    _filters.push_back(filter);
+}
+
+void GoertzelBank::clear() {
+    _filters.clear();
+}
+
+void GoertzelBank::reset() {
+    for (Filter &filter : _filters) {
+        filter.s1 = filter.s2 = 0.0;
+        filter.count = 0;
+        filter.magnitude = 0.0f;
+    }
+}
+
+void GoertzelBank::push(const float *samples, unsigned count) {
+    for (Filter &filter : _filters) {
+        double s1 = filter.s1, s2 = filter.s2;
+        const double coefficient = filter.coefficient;
+
+        for (unsigned i = 0; i < count; i++) {
+            double s0 = samples[i] + coefficient * s1 - s2;
+            s2 = s1;
+            s1 = s0;
+
+            if (++filter.count == filter.blockLength) {
+                // y = s(N-1) - e^(-i omega) s(N-2), |y| = |X(f)|
+                double real = s1 - filter.cosine * s2;
+                double imag = filter.sine * s2;
+                filter.magnitude = float(std::sqrt(real * real + imag * imag));
+                s1 = s2 = 0.0;
+                filter.count = 0;
+            }
+        }
+
+        filter.s1 = s1;
+        filter.s2 = s2;
+    }
+}
+
+unsigned GoertzelBank::wholePeriods(float frequency, unsigned approximateLength) {
+    double period = _samplingFrequency / frequency;
+    double periods = std::max(1.0, std::round(approximateLength / period));
+    return unsigned(std::lround(periods * period));
+}
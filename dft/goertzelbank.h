@@ -0,0 +1,66 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef GOERTZELBANK_H
+#define GOERTZELBANK_H
+
+#include <vector>
+
+// Bank of Goertzel filters, for when only a few frequencies matter
+// (mains hum and its harmonics, pilot tones, tuner targets...): each one
+// costs a multiply and two adds per sample, instead of a whole FFT.
+// Every filter has its own block length, so it can be tuned to a whole
+// number of periods of its frequency, which keeps the leakage low.
+// Samples are streamed in with push(); a filter's magnitude is updated
+// whenever one of its blocks is complete.
+class GoertzelBank {
+private:
+    struct Filter {
+        float frequency;
+        unsigned blockLength;
+        double coefficient, cosine, sine;
+        double s1, s2;
+        unsigned count;
+        float magnitude;
+    };
+
+    float _samplingFrequency;
+    std::vector<Filter> _filters;
+
+public:
+    explicit GoertzelBank(float samplingFrequency);
+
+    // blockLength = 0 picks wholePeriods(frequency, 4096)
+    void add(float frequency, unsigned blockLength = 0);
+    void clear();
+
+    unsigned size() { return unsigned(_filters.size()); }
+    float frequency(unsigned i) { return _filters[i].frequency; }
+    unsigned blockLength(unsigned i) { return _filters[i].blockLength; }
+
+    // |X(f)| of the last complete block of the filter, on the same scale as
+    // a DFT of blockLength samples, 0 until the first block is complete
+    float magnitude(unsigned i) { return _filters[i].magnitude; }
+
+    void push(const float *samples, unsigned count);
+
+    // Forgets the blocks in progress and the magnitudes
+    void reset();
+
+    // The length closest to approximateLength that holds a whole number of periods
+    unsigned wholePeriods(float frequency, unsigned approximateLength);
+};
+
+#endif // GOERTZELBANK_H
@@ -0,0 +1,312 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <cmath>
+#include "magnitude.h"
+#include "cpufeatures.h"
+
+#if defined(SIMD_X86)
+#include <immintrin.h>
+
+// Same as fastLog2, 4 or 8 values at a time
+
+SIMD_TARGET_SSE2 static inline __m128 fastLog2Sse2(__m128 x) {
+    __m128i bits = _mm_castps_si128(x);
+    __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+    __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 t = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+    __m128 t2 = _mm_mul_ps(t, t);
+    __m128 series = _mm_add_ps(_mm_set1_ps(0.577078016f), _mm_mul_ps(t2, _mm_set1_ps(0.412198583f)));
+    series = _mm_add_ps(_mm_set1_ps(0.961796694f), _mm_mul_ps(t2, series));
+    series = _mm_add_ps(_mm_set1_ps(2.88539008f), _mm_mul_ps(t2, series));
+    return _mm_add_ps(exponent, _mm_mul_ps(t, series));
+}
+
+SIMD_TARGET_AVX2 static inline __m256 fastLog2Avx2(__m256 x) {
+    __m256i bits = _mm256_castps_si256(x);
+    __m256 exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f800000)));
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 t = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+    __m256 t2 = _mm256_mul_ps(t, t);
+    __m256 series = _mm256_fmadd_ps(t2, _mm256_set1_ps(0.412198583f), _mm256_set1_ps(0.577078016f));
+    series = _mm256_fmadd_ps(t2, series, _mm256_set1_ps(0.961796694f));
+    series = _mm256_fmadd_ps(t2, series, _mm256_set1_ps(2.88539008f));
+    return _mm256_fmadd_ps(t, series, exponent);
+}
+
+#endif
+
+// |X|² of the bins, one at a time or 4 / 8 at a time, in both layouts.
+// The kernels below are written once against these.
+struct InterleavedBins {
+    const float *b;
+
+    inline float power(unsigned i) const {
+        return b[2 * i] * b[2 * i] + b[2 * i + 1] * b[2 * i + 1];
+    }
+
+#if defined(SIMD_X86)
+    // Re and im of 4 bins: (r0, i0, r1, i1), (r2, i2, r3, i3) -> r0² + i0², ..., r3² + i3²
+    SIMD_TARGET_SSE2 inline __m128 power4(unsigned i) const {
+        __m128 lo = _mm_loadu_ps(b + 2 * i);
+        __m128 hi = _mm_loadu_ps(b + 2 * i + 4);
+        __m128 re = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 im = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+        return _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+    }
+
+    // Same for 8 bins. The in-lane shuffles leave them in the order
+    // 0, 1, 4, 5, 2, 3, 6, 7, which the final permute puts back.
+    SIMD_TARGET_AVX2 inline __m256 power8(unsigned i) const {
+        __m256 lo = _mm256_loadu_ps(b + 2 * i);
+        __m256 hi = _mm256_loadu_ps(b + 2 * i + 8);
+        __m256 re = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 im = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 power = _mm256_fmadd_ps(re, re, _mm256_mul_ps(im, im));
+        return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(power), _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+#endif
+};
+
+struct SplitBins {
+    const float *real;
+    const float *imag;
+
+    inline float power(unsigned i) const {
+        return real[i] * real[i] + imag[i] * imag[i];
+    }
+
+#if defined(SIMD_X86)
+    SIMD_TARGET_SSE2 inline __m128 power4(unsigned i) const {
+        __m128 re = _mm_loadu_ps(real + i);
+        __m128 im = _mm_loadu_ps(imag + i);
+        return _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+    }
+
+    SIMD_TARGET_AVX2 inline __m256 power8(unsigned i) const {
+        __m256 re = _mm256_loadu_ps(real + i);
+        __m256 im = _mm256_loadu_ps(imag + i);
+        return _mm256_fmadd_ps(re, re, _mm256_mul_ps(im, im));
+    }
+#endif
+};
+
+// The vector loops of every kernel return how many bins they did,
+// the plain loop of the kernel does the rest.
+
+// 10 log10(p) = 10 log10(2) log2(p)
+static const float decibelScale = 3.01029996f;
+
+#if defined(SIMD_X86)
+
+template <typename Bins>
+SIMD_TARGET_SSE2 static unsigned powerSse2(Bins bins, float *power, unsigned count) {
+    unsigned i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(power + i, bins.power4(i));
+    }
+    return i;
+}
+
+template <typename Bins>
+SIMD_TARGET_AVX2 static unsigned powerAvx2(Bins bins, float *power, unsigned count) {
+    unsigned i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(power + i, bins.power8(i));
+    }
+    return i;
+}
+
+// Running maximum and its index in every lane, merged at the end
+template <typename Bins>
+SIMD_TARGET_SSE2 static unsigned magnitudeSse2(Bins bins, float *magnitudes, unsigned count, float &maxValue, unsigned &maxIndex) {
+    unsigned i = 0;
+    __m128 maxValues = _mm_set1_ps(-1.0f);
+    __m128i maxIndices = _mm_setzero_si128();
+    __m128i indices = _mm_set_epi32(3, 2, 1, 0);
+    const __m128i four = _mm_set1_epi32(4);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 magnitude = _mm_sqrt_ps(bins.power4(i));
+        _mm_storeu_ps(magnitudes + i, magnitude);
+
+        __m128i greater = _mm_castps_si128(_mm_cmpgt_ps(magnitude, maxValues));
+        maxValues = _mm_max_ps(maxValues, magnitude);
+        maxIndices = _mm_or_si128(_mm_and_si128(greater, indices), _mm_andnot_si128(greater, maxIndices));
+        indices = _mm_add_epi32(indices, four);
+    }
+
+    alignas(16) float values[4];
+    alignas(16) int32_t positions[4];
+    _mm_store_ps(values, maxValues);
+    _mm_store_si128(reinterpret_cast<__m128i *>(positions), maxIndices);
+    for (int l = 0; l < 4; l++) {
+        if (values[l] > maxValue || (values[l] == maxValue && unsigned(positions[l]) < maxIndex)) {
+            maxValue = values[l];
+            maxIndex = unsigned(positions[l]);
+        }
+    }
+    return i;
+}
+
+template <typename Bins>
+SIMD_TARGET_AVX2 static unsigned magnitudeAvx2(Bins bins, float *magnitudes, unsigned count, float &maxValue, unsigned &maxIndex) {
+    unsigned i = 0;
+    __m256 maxValues = _mm256_set1_ps(-1.0f);
+    __m256i maxIndices = _mm256_setzero_si256();
+    __m256i indices = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i eight = _mm256_set1_epi32(8);
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 magnitude = _mm256_sqrt_ps(bins.power8(i));
+        _mm256_storeu_ps(magnitudes + i, magnitude);
+
+        __m256i greater = _mm256_castps_si256(_mm256_cmp_ps(magnitude, maxValues, _CMP_GT_OQ));
+        maxValues = _mm256_max_ps(maxValues, magnitude);
+        maxIndices = _mm256_blendv_epi8(maxIndices, indices, greater);
+        indices = _mm256_add_epi32(indices, eight);
+    }
+
+    alignas(32) float values[8];
+    alignas(32) int32_t positions[8];
+    _mm256_store_ps(values, maxValues);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(positions), maxIndices);
+    for (int l = 0; l < 8; l++) {
+        if (values[l] > maxValue || (values[l] == maxValue && unsigned(positions[l]) < maxIndex)) {
+            maxValue = values[l];
+            maxIndex = unsigned(positions[l]);
+        }
+    }
+    return i;
+}
+
+template <typename Bins>
+SIMD_TARGET_SSE2 static unsigned decibelSse2(Bins bins, float *decibels, unsigned count, float floorPower) {
+    unsigned i = 0;
+    const __m128 floorPowers = _mm_set1_ps(floorPower);
+    const __m128 scales = _mm_set1_ps(decibelScale);
+    for (; i + 4 <= count; i += 4) {
+        __m128 power = _mm_add_ps(bins.power4(i), floorPowers);
+        _mm_storeu_ps(decibels + i, _mm_mul_ps(scales, fastLog2Sse2(power)));
+    }
+    return i;
+}
+
+template <typename Bins>
+SIMD_TARGET_AVX2 static unsigned decibelAvx2(Bins bins, float *decibels, unsigned count, float floorPower) {
+    unsigned i = 0;
+    const __m256 floorPowers = _mm256_set1_ps(floorPower);
+    const __m256 scales = _mm256_set1_ps(decibelScale);
+    for (; i + 8 <= count; i += 8) {
+        __m256 power = _mm256_add_ps(bins.power8(i), floorPowers);
+        _mm256_storeu_ps(decibels + i, _mm256_mul_ps(scales, fastLog2Avx2(power)));
+    }
+    return i;
+}
+
+#endif
+
+template <typename Bins>
+static void powerSpectrum(Bins bins, float *power, unsigned count) {
+    unsigned i = 0;
+
+#if defined(SIMD_X86)
+    static const SimdLevel level = simdLevel();
+    if (level >= SimdLevel::Avx2) {
+        i = powerAvx2(bins, power, count);
+    }
+    else if (level >= SimdLevel::Sse2) {
+        i = powerSse2(bins, power, count);
+    }
+#endif
+
+    for (; i < count; i++) {
+        power[i] = bins.power(i);
+    }
+}
+
+template <typename Bins>
+static unsigned magnitudeSpectrum(Bins bins, float *magnitudes, unsigned count) {
+    unsigned i = 0;
+    float maxValue = -1.0f;
+    unsigned maxIndex = 0;
+
+#if defined(SIMD_X86)
+    static const SimdLevel level = simdLevel();
+    if (level >= SimdLevel::Avx2 && count >= 8) {
+        i = magnitudeAvx2(bins, magnitudes, count, maxValue, maxIndex);
+    }
+    else if (level >= SimdLevel::Sse2 && count >= 4) {
+        i = magnitudeSse2(bins, magnitudes, count, maxValue, maxIndex);
+    }
+#endif
+
+    for (; i < count; i++) {
+        magnitudes[i] = std::sqrt(bins.power(i));
+        if (magnitudes[i] > maxValue) {
+            maxValue = magnitudes[i];
+            maxIndex = i;
+        }
+    }
+
+    return maxIndex;
+}
+
+template <typename Bins>
+static void decibelSpectrum(Bins bins, float *decibels, unsigned count, float floorPower) {
+    unsigned i = 0;
+
+#if defined(SIMD_X86)
+    static const SimdLevel level = simdLevel();
+    if (level >= SimdLevel::Avx2) {
+        i = decibelAvx2(bins, decibels, count, floorPower);
+    }
+    else if (level >= SimdLevel::Sse2) {
+        i = decibelSse2(bins, decibels, count, floorPower);
+    }
+#endif
+
+    for (; i < count; i++) {
+        decibels[i] = decibelScale * fastLog2(bins.power(i) + floorPower);
+    }
+}
+
+void powerSpectrum(const std::complex<float> *bins, float *power, unsigned count) {
+    powerSpectrum(InterleavedBins{reinterpret_cast<const float *>(bins)}, power, count);
+}
+
+void powerSpectrum(const float *real, const float *imag, float *power, unsigned count) {
+    powerSpectrum(SplitBins{real, imag}, power, count);
+}
+
+unsigned magnitudeSpectrum(const std::complex<float> *bins, float *magnitudes, unsigned count) {
+    return magnitudeSpectrum(InterleavedBins{reinterpret_cast<const float *>(bins)}, magnitudes, count);
+}
+
+unsigned magnitudeSpectrum(const float *real, const float *imag, float *magnitudes, unsigned count) {
+    return magnitudeSpectrum(SplitBins{real, imag}, magnitudes, count);
+}
+
+void decibelSpectrum(const std::complex<float> *bins, float *decibels, unsigned count, float floorPower) {
+    decibelSpectrum(InterleavedBins{reinterpret_cast<const float *>(bins)}, decibels, count, floorPower);
+}
+
+void decibelSpectrum(const float *real, const float *imag, float *decibels, unsigned count, float floorPower) {
+    decibelSpectrum(SplitBins{real, imag}, decibels, count, floorPower);
+}
@@ -0,0 +1,61 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef MAGNITUDE_H
+#define MAGNITUDE_H
+
+#include <complex>
+#include <cstdint>
+#include <cstring>
+
+// Post-FFT kernels: turn the complex bins into a real array in one pass,
+// without std::abs (which goes through hypot) or std::log10 per bin.
+// Downstream code should read the array instead of the bins.
+// Every kernel takes interleaved bins or a split spectrum (real and imag
+// arrays, see SplitSpectrum); the split one needs no shuffles.
+
+// |X|²
+void powerSpectrum(const std::complex<float> *bins, float *power, unsigned count);
+void powerSpectrum(const float *real, const float *imag, float *power, unsigned count);
+
+// |X|, returns the index of the largest one (the first one if several)
+unsigned magnitudeSpectrum(const std::complex<float> *bins, float *magnitudes, unsigned count);
+unsigned magnitudeSpectrum(const float *real, const float *imag, float *magnitudes, unsigned count);
+
+// 10 log10(|X|² + floorPower), with fastLog2; the floor keeps silence finite
+void decibelSpectrum(const std::complex<float> *bins, float *decibels, unsigned count, float floorPower = 1e-20f);
+void decibelSpectrum(const float *real, const float *imag, float *decibels, unsigned count, float floorPower = 1e-20f);
+
+// log2 for positive, normal floats, within 3e-5 of the exact value.
+// x = m 2^e with m in [1, 2), and log2(m) = 2 atanh((m - 1) / (m + 1)) / ln 2
+// from the first four terms of its series.
+inline float fastLog2(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    float exponent = float(int((bits >> 23) & 0xff) - 127);
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+
+    float t = (m - 1.0f) / (m + 1.0f);
+    float t2 = t * t;
+    return exponent + t * (2.88539008f + t2 * (0.961796694f + t2 * (0.577078016f + t2 * 0.412198583f)));
+}
+
+inline float fastLog10(float x) {
+    return fastLog2(x) * 0.301029996f;
+}
+
+#endif // MAGNITUDE_H
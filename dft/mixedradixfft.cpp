@@ -0,0 +1,169 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <iostream>
+#include "mixedradixfft.h"
+
+// Plain complex product, without the NaN/infinity recovery of operator*
+static inline std::complex<float> multiply(std::complex<float> a, std::complex<float> b) {
+    return std::complex<float>(a.real() * b.real() - a.imag() * b.imag(),
+                               a.real() * b.imag() + a.imag() * b.real());
+}
+
+// One pass of radix P over sub-sequences of length n at stride s (n * s = N).
+// y[q + s*(P*j + t)] = W_n^(jt) * sum_r x[q + s*(j + r*n/P)] * W_P^(rt)
+template <unsigned P>
+static void radixPass(const std::complex<float> *x, std::complex<float> *y, unsigned n, unsigned s, const std::complex<float> *roots) {
+    const unsigned m = n / P;
+    const unsigned N = n * s;
+
+    // W_P^i = W_N^(i*N/P)
+    std::complex<float> wp[P];
+    for (unsigned i = 0; i < P; i++) {
+        wp[i] = roots[i * (N / P)];
+    }
+
+    std::complex<float> a[P];
+    for (unsigned j = 0; j < m; j++) {
+        for (unsigned q = 0; q < s; q++) {
+            for (unsigned r = 0; r < P; r++) {
+                a[r] = x[q + s * (j + r * m)];
+            }
+
+            for (unsigned t = 0; t < P; t++) {
+                std::complex<float> sum = a[0];
+                unsigned rt = 0;
+                for (unsigned r = 1; r < P; r++) {
+                    rt += t;
+                    if (rt >= P) {
+                        rt -= P;
+                    }
+                    sum += multiply(a[r], wp[rt]);
+                }
+                y[q + s * (P * j + t)] = multiply(sum, roots[j * t * s]);
+            }
+        }
+    }
+}
+
+template <>
+void radixPass<2>(const std::complex<float> *x, std::complex<float> *y, unsigned n, unsigned s, const std::complex<float> *roots) {
+    const unsigned m = n / 2;
+
+    for (unsigned j = 0; j < m; j++) {
+        const std::complex<float> w = roots[j * s];
+        for (unsigned q = 0; q < s; q++) {
+            auto a0 = x[q + s * j];
+            auto a1 = x[q + s * (j + m)];
+            y[q + s * (2 * j)] = a0 + a1;
+            y[q + s * (2 * j + 1)] = multiply(a0 - a1, w);
+        }
+    }
+}
+
+template <>
+void radixPass<4>(const std::complex<float> *x, std::complex<float> *y, unsigned n, unsigned s, const std::complex<float> *roots) {
+    const unsigned m = n / 4;
+
+    for (unsigned j = 0; j < m; j++) {
+        const std::complex<float> w1 = roots[j * s];
+        const std::complex<float> w2 = roots[2 * j * s];
+        const std::complex<float> w3 = roots[3 * j * s];
+        for (unsigned q = 0; q < s; q++) {
+            auto a0 = x[q + s * j];
+            auto a1 = x[q + s * (j + m)];
+            auto a2 = x[q + s * (j + 2 * m)];
+            auto a3 = x[q + s * (j + 3 * m)];
+
+            auto s02 = a0 + a2;
+            auto d02 = a0 - a2;
+            auto s13 = a1 + a3;
+            auto d13 = a1 - a3;
+            // -j * d13
+            auto jd13 = std::complex<float>(d13.imag(), -d13.real());
+
+            y[q + s * (4 * j)] = s02 + s13;
+            y[q + s * (4 * j + 1)] = multiply(d02 + jd13, w1);
+            y[q + s * (4 * j + 2)] = multiply(s02 - s13, w2);
+            y[q + s * (4 * j + 3)] = multiply(d02 - jd13, w3);
+        }
+    }
+}
+
+static std::vector<unsigned> factorize(unsigned sampleCount) {
+    std::vector<unsigned> factors;
+    unsigned n = sampleCount;
+
+    while (n % 4 == 0) {
+        factors.push_back(4);
+        n /= 4;
+    }
+    for (unsigned p : { 2u, 3u, 5u, 7u }) {
+        while (n % p == 0) {
+            factors.push_back(p);
+            n /= p;
+        }
+    }
+
+    if (n != 1) {
+        factors.clear();
+    }
+    return factors;
+}
+
+bool MixedRadixFft::supports(unsigned sampleCount) {
+    return sampleCount == 1 || !factorize(sampleCount).empty();
+}
+
+MixedRadixFft::MixedRadixFft(unsigned sampleCount) : Dft(sampleCount) {
+    if (!supports(sampleCount)) {
+        std::cout << "sample count should only have 2, 3, 5 and 7 as factors, but it's " << sampleCount << std::endl;
+        throw std::exception();
+    }
+
+    _factors = factorize(sampleCount);
+    _twiddles = TwiddleTable::forSize(sampleCount);
+    workspace().resize(0, sampleCount);
+}
+
+void MixedRadixFft::compute(const float *samples, std::complex<float> *result) {
+    unsigned N = sampleCount();
+    const std::complex<float> *roots = _twiddles->roots();
+
+    // Start in the buffer that makes the last pass write into the result
+    std::complex<float> *x = (_factors.size() % 2) ? workspace().complex() : result;
+    std::complex<float> *y = (_factors.size() % 2) ? result : workspace().complex();
+
+    const float *window = windowCoefficients();
+    for (unsigned i = 0; i < N; i++) {
+        x[i] = window ? samples[i] * window[i] : samples[i];
+    }
+
+    unsigned n = N;
+    unsigned s = 1;
+    for (unsigned p : _factors) {
+        switch (p) {
+        case 2: radixPass<2>(x, y, n, s, roots); break;
+        case 3: radixPass<3>(x, y, n, s, roots); break;
+        case 4: radixPass<4>(x, y, n, s, roots); break;
+        case 5: radixPass<5>(x, y, n, s, roots); break;
+        case 7: radixPass<7>(x, y, n, s, roots); break;
+        }
+
+        n /= p;
+        s *= p;
+        std::swap(x, y);
+    }
+}
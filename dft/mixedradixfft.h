@@ -0,0 +1,41 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef MIXEDRADIXFFT_H
+#define MIXEDRADIXFFT_H
+
+#include "dft.h"
+#include "twiddletable.h"
+
+// Stockham autosort FFT for sizes whose prime factors are all 2, 3, 5 or 7,
+// eg. 480, 960 or 1920 (10, 20 or 40 ms at 48 kHz).
+// Each pass reads one buffer and writes the other, so there is no
+// reordering of the input or the output.
+class MixedRadixFft final : public Dft {
+private:
+    std::vector<unsigned> _factors;
+    std::shared_ptr<const TwiddleTable> _twiddles;
+
+public:
+    explicit MixedRadixFft(unsigned sampleCount);
+
+    using Dft::compute;
+    void compute(const float *samples, std::complex<float> *result);
+
+    // Whether the size can be factored into 2, 3, 5 and 7
+    static bool supports(unsigned sampleCount);
+};
+
+#endif // MIXEDRADIXFFT_H
@@ -0,0 +1,134 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <algorithm>
+#include <iostream>
+#include "overlapsave.h"
+
+// acc += x * h on ffft packed spectra of size n: real parts in [0, n/2],
+// negated imaginary parts of bins 1 ... n/2-1 in [n/2+1, n).
+// Negating both imaginary parts conjugates the product, which is the
+// product of the conjugates, so the usual complex product applies as is.
+static void multiplyAdd(float *acc, const float *x, const float *h, unsigned n) {
+    const unsigned half = n / 2;
+    acc[0] += x[0] * h[0];
+    acc[half] += x[half] * h[half];
+
+    float *accImag = acc + half;
+    const float *xImag = x + half;
+    const float *hImag = h + half;
+    for (unsigned i = 1; i < half; i++) {
+        const float xr = x[i], xi = xImag[i];
+        const float hr = h[i], hi = hImag[i];
+        acc[i] += xr * hr - xi * hi;
+        accImag[i] += xr * hi + xi * hr;
+    }
+}
+
+OverlapSaveFilter::OverlapSaveFilter(const float *taps, unsigned tapCount, unsigned blockSize)
+    : _blockSize(blockSize),
+      _tapCount(tapCount),
+      _partitionCount(0),
+      _newest(0),
+      _position(0) {
+    if (blockSize == 0 || (blockSize & (blockSize - 1)) != 0) {
+        std::cout << "overlap-save block size should be a power of 2, but it's " << blockSize << std::endl;
+        throw std::exception();
+    }
+    if (tapCount == 0) {
+        std::cout << "overlap-save filter needs at least one tap" << std::endl;
+        throw std::exception();
+    }
+
+    const unsigned B = blockSize;
+    const unsigned N = 2 * B;
+    _partitionCount = (tapCount + B - 1) / B;
+    _fft = RealFft::tablesForSize(N);
+
+    _partitions.resize(size_t(_partitionCount) * N);
+    _history.resize(size_t(_partitionCount) * N);
+    _input.resize(N);
+    _output.resize(B);
+    _accumulator.resize(N);
+    _time.resize(N);
+    _scratch.resize(N);
+
+    // Each partition zero-padded to N, the 1 / N of the inverse FFT is folded in here
+    const float scale = 1.0f / float(N);
+    for (unsigned p = 0; p < _partitionCount; p++) {
+        const unsigned first = p * B;
+        const unsigned count = std::min(B, tapCount - first);
+        std::fill(_time.begin(), _time.end(), 0.0f);
+        for (unsigned i = 0; i < count; i++) {
+            _time[i] = taps[first + i] * scale;
+        }
+        _fft->do_fft(_partitions.data() + size_t(p) * N, _time.data(), _scratch.data());
+    }
+
+    reset();
+}
+
+void OverlapSaveFilter::reset() {
+    std::fill(_history.begin(), _history.end(), 0.0f);
+    std::fill(_input.begin(), _input.end(), 0.0f);
+    std::fill(_output.begin(), _output.end(), 0.0f);
+    _newest = 0;
+    _position = 0;
+}
+
+void OverlapSaveFilter::process(float *samples, unsigned count) {
+    const unsigned B = _blockSize;
+
+    while (count > 0) {
+        const unsigned take = std::min(count, B - _position);
+        float *current = _input.data() + B + _position;
+        const float *ready = _output.data() + _position;
+        for (unsigned i = 0; i < take; i++) {
+            current[i] = samples[i];
+            samples[i] = ready[i];
+        }
+
+        samples += take;
+        count -= take;
+        _position += take;
+        if (_position == B) {
+            processBlock();
+            _position = 0;
+        }
+    }
+}
+
+void OverlapSaveFilter::processBlock() {
+    const unsigned B = _blockSize;
+    const unsigned N = 2 * B;
+    const unsigned P = _partitionCount;
+
+    // The spectrum of [previous block, current block] replaces the oldest one
+    _newest = (_newest == 0) ? P - 1 : _newest - 1;
+    _fft->do_fft(_history.data() + size_t(_newest) * N, _input.data(), _scratch.data());
+
+    // Partition p applies to the input of p blocks ago
+    std::fill(_accumulator.begin(), _accumulator.end(), 0.0f);
+    unsigned slot = _newest;
+    for (unsigned p = 0; p < P; p++) {
+        multiplyAdd(_accumulator.data(), _history.data() + size_t(slot) * N, _partitions.data() + size_t(p) * N, N);
+        slot = (slot + 1 == P) ? 0 : slot + 1;
+    }
+
+    // The first half wraps around, only the second half is the linear convolution
+    _fft->do_ifft(_accumulator.data(), _time.data(), _scratch.data());
+    std::copy(_time.begin() + B, _time.end(), _output.begin());
+    std::copy(_input.begin() + B, _input.end(), _input.begin());
+}
@@ -0,0 +1,70 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef OVERLAPSAVE_H
+#define OVERLAPSAVE_H
+
+#include <memory>
+#include "alignedallocator.h"
+#include "realfft.h"
+
+// FIR filter of any length, computed as a uniformly partitioned
+// overlap-save convolution.
+// The taps are cut into partitions of blockSize, each one transformed
+// once with a 2 * blockSize ffft FFT. Every block of input is transformed
+// once too, and its spectrum is kept in a delay line: the output block is
+// the inverse FFT of sum(X[k - p] * H[p]) over the partitions, so a block
+// costs two FFTs and one complex multiply-add per partition, whatever the
+// number of taps.
+// The output is delayed by blockSize samples (the latency), independently
+// of the filter length.
+class OverlapSaveFilter {
+private:
+    unsigned _blockSize;
+    unsigned _tapCount;
+    unsigned _partitionCount;
+    std::shared_ptr<const RealFft::Tables> _fft;
+    // ffft packed spectra of the partitions, already scaled by 1 / (2 * blockSize)
+    AlignedVector<float> _partitions;
+    // ffft packed spectra of the last _partitionCount inputs, _newest is the latest
+    AlignedVector<float> _history;
+    unsigned _newest;
+    // The previous block and the one being filled
+    AlignedVector<float> _input;
+    // Filtered samples of the previous block, handed out while the next one fills
+    AlignedVector<float> _output;
+    unsigned _position;
+    AlignedVector<float> _accumulator;
+    AlignedVector<float> _time;
+    AlignedVector<float> _scratch;
+
+    void processBlock();
+
+public:
+    // blockSize should be a power of 2
+    OverlapSaveFilter(const float *taps, unsigned tapCount, unsigned blockSize);
+
+    unsigned blockSize() { return _blockSize; }
+    unsigned tapCount() { return _tapCount; }
+    unsigned latency() { return _blockSize; }
+
+    // Filters the samples in place, any count at a time
+    void process(float *samples, unsigned count);
+
+    // Forgets every sample, as if silence had been filtered so far
+    void reset();
+};
+
+#endif // OVERLAPSAVE_H
@@ -13,72 +13,102 @@
 //
 // Copyright (c) 2014 Timur Kristóf
 
+#include <algorithm>
 #include <iostream>
 #include "radix2fft.h"
+#include "butterfly.h"
 
-static inline unsigned reverseBits(unsigned input, unsigned b) {
-    unsigned result = 0;
-    for (unsigned i = 0; i < b / 2 + 1; i++) {
-        result |= (input & (1 << i)) << (b - 2 * i - 1);
-        result |= (input & (1 << (b - i - 1))) >> (b - 2 * i - 1);
-    }
-    return result;
-}
-
-Radix2Fft::Radix2Fft(unsigned sampleCount) : Dft(sampleCount) {
-    _log2sc = std::log2(sampleCount);
+template <typename T>
+BasicRadix2Fft<T>::BasicRadix2Fft(unsigned sampleCount, Kernel kernel) : BasicDft<T>(sampleCount), _kernel(kernel), _log2sc(std::log2(sampleCount)), _reversal(sampleCount > 1 ? unsigned(_log2sc) : 0) {
     if (sampleCount != std::pow(2, _log2sc)) {
         std::cout << "sample count should be a power of 2, but it's " << sampleCount << std::endl;
         throw std::exception();
     }
 
-    _indices = std::vector<unsigned>(sampleCount);
-    for (unsigned i = sampleCount; i--; ) {
-        _indices[i] = reverseBits(i, _log2sc);
-    }
+    _twiddles = BasicTwiddleTable<T>::forSize(sampleCount);
 }
 
-std::vector<std::complex<float> > Radix2Fft::compute(const std::vector<float> &samples) {
-    // Check input size
-    unsigned N = sampleCount();
-    if (samples.size() < N) {
-        std::cout << "sample count is: " << samples.size() << ", expected: " << N << std::endl;
-        throw std::exception();
+template <typename T>
+void BasicRadix2Fft<T>::compute(const T *samples, std::complex<T> *result) {
+    // Load the samples in bit-reversed order, windowed on the way, then work in place
+    const T *window = this->windowCoefficients();
+    if (window) {
+        _reversal.copy(samples, window, result);
+    }
+    else {
+        _reversal.copy(samples, result);
     }
+    butterflies(result);
+}
 
-    // Create some constants
-    const float pi = std::acos(-1.0f);
-    const std::complex<float> j(0, 1.0f);
+template <typename T>
+void BasicRadix2Fft<T>::computeBatch(const T *const *frames, std::complex<T> *const *results, unsigned count) {
+    unsigned N = this->sampleCount();
 
-    // Create result array
-    std::vector<std::complex<float> > result(N);
-    for (unsigned i = 0; i < N; i++) {
-        result[_indices[i]] = samples[i];
+    // Allocated on the first batch only, most engines never see one
+    if (_batch.empty()) {
+        _batch.resize(2 * N * batchLanes);
     }
+    T *re = _batch.data();
+    T *im = re + N * batchLanes;
+    const T *window = this->windowCoefficients();
 
-    unsigned pow2 = 1;
-    for (unsigned level = 0; level < _log2sc; level++, pow2 *= 2) {
+    for (unsigned first = 0; first < count; first += batchLanes) {
+        unsigned lanes = std::min(batchLanes, count - first);
+
+        // Bit-reversed and windowed load, unused lanes are left at zero
+        _reversal.forEach([&](unsigned i, unsigned j) {
+            T *r = re + j * batchLanes;
+            const T w = window ? window[i] : T(1);
+            for (unsigned l = 0; l < batchLanes; l++) {
+                r[l] = (l < lanes) ? frames[first + l][i] * w : T(0);
+            }
+        });
+        std::fill(im, im + N * batchLanes, T(0));
 
-        // Calculate exponential multipliers for the current stage
-        std::vector<std::complex<float> > multipliers(pow2);
-        for (unsigned i = 0; i < pow2; i++) {
-            multipliers[i] = std::exp((-j * 2.0f * pi / (float)(pow2 * 2)) * (float)i);
+        unsigned pow2 = 1;
+        for (unsigned level = 0; level < _log2sc; level++, pow2 *= 2) {
+            if (_kernel == Vectorized) {
+                batchButterflyPass(re, im, N, pow2, _twiddles->stage(pow2));
+            }
+            else {
+                batchButterflyPassScalar(re, im, N, pow2, _twiddles->stage(pow2));
+            }
         }
 
-        // Do each DFT in this stage
-        for (unsigned a = 0; a < N; a += pow2 * 2) {
-            // Visit all butterflies in the current DFT
-            for (unsigned b = 0; b < pow2; b++) {
-                unsigned i = a + b;
-
-                // Compute a single butterfly
-                auto u = result[i];
-                auto v = result[i + pow2] * multipliers[b];
-                result[i] = u + v;
-                result[i + pow2] = u - v;
+        for (unsigned l = 0; l < lanes; l++) {
+            std::complex<T> *result = results[first + l];
+            for (unsigned k = 0; k < N; k++) {
+                result[k] = std::complex<T>(re[k * batchLanes + l], im[k * batchLanes + l]);
             }
         }
     }
+}
 
-    return result;
+template <typename T>
+void BasicRadix2Fft<T>::transform(std::complex<T> *data) {
+    _reversal.permute(data);
+    butterflies(data);
 }
+
+template <typename T>
+void BasicRadix2Fft<T>::butterflies(std::complex<T> *data) {
+    unsigned N = this->sampleCount();
+
+    unsigned pow2 = 1;
+    for (unsigned level = 0; level < _log2sc; level++, pow2 *= 2) {
+        // Exponential multipliers for the current stage
+        const std::complex<T> *multipliers = _twiddles->stage(pow2);
+
+        // Do each DFT in this stage
+        if (_kernel == Vectorized) {
+            butterflyPass(data, N, pow2, multipliers);
+        }
+        else {
+            butterflyPassScalar(data, N, pow2, multipliers);
+        }
+    }
+}
+
+template class BasicRadix2Fft<float>;
+template class BasicRadix2Fft<double>;
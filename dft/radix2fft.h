@@ -17,16 +17,42 @@
 #define RADIX2FFT_H
 
 #include "dft.h"
+#include "twiddletable.h"
+#include "bitreversal.h"
+
+template <typename T>
+class BasicRadix2Fft final : public BasicDft<T> {
+public:
+    enum Kernel {
+        // Plain C++ butterflies, used as the reference for the SIMD ones
+        Scalar,
+        // The widest SIMD butterflies the build supports (float only,
+        // the double engine always runs the plain C++ ones)
+        Vectorized
+    };
 
-class Radix2Fft final : public Dft {
 private:
+    Kernel _kernel;
     double _log2sc;
-    std::vector<unsigned> _indices;
+    BitReversal _reversal;
+    std::shared_ptr<const BasicTwiddleTable<T> > _twiddles;
+    AlignedVector<T> _batch;
+
+    void butterflies(std::complex<T> *data);
 
 public:
-    explicit Radix2Fft(unsigned sampleCount);
+    explicit BasicRadix2Fft(unsigned sampleCount, Kernel kernel = Vectorized);
 
-    std::vector<std::complex<float> > compute(const std::vector<float> &samples);
+    using BasicDft<T>::compute;
+    void compute(const T *samples, std::complex<T> *result);
+
+    // Runs batchLanes frames side by side in the SIMD lanes
+    void computeBatch(const T *const *frames, std::complex<T> *const *results, unsigned count);
+
+    // In-place FFT of sampleCount() complex values, for engines built on this one
+    void transform(std::complex<T> *data);
 };
 
+typedef BasicRadix2Fft<float> Radix2Fft;
+
 #endif // RADIX2FFT_H
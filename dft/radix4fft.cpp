@@ -0,0 +1,109 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <iostream>
+#include "radix4fft.h"
+
+// Plain complex product, without the NaN/infinity recovery of operator*
+static inline std::complex<float> multiply(std::complex<float> a, std::complex<float> b) {
+    return std::complex<float>(a.real() * b.real() - a.imag() * b.imag(),
+                               a.real() * b.imag() + a.imag() * b.real());
+}
+
+Radix4Fft::Radix4Fft(unsigned sampleCount) : Dft(sampleCount), _reversal(0) {
+    if (sampleCount == 0 || (sampleCount & (sampleCount - 1)) != 0) {
+        std::cout << "sample count should be a power of 2, but it's " << sampleCount << std::endl;
+        throw std::exception();
+    }
+
+    _log2sc = 0;
+    while ((1u << _log2sc) < sampleCount) {
+        _log2sc++;
+    }
+
+    // The passes below read their four DFTs in bit-reversed order too,
+    // so plain bit reversal (not base-4 digit reversal) is the load order
+    _reversal = BitReversal(_log2sc);
+
+    // Multipliers of every radix-4 pass, one after the other.
+    // The pass that combines DFTs of size m needs w^k, w^2k, w^3k
+    // for every k < m, where w = exp(-2πj / 4m).
+    std::shared_ptr<const TwiddleTable> twiddles = TwiddleTable::forSize(sampleCount);
+    const std::complex<float> *roots = twiddles->roots();
+    for (unsigned m = (_log2sc % 2) ? 2 : 1; m * 4 <= sampleCount; m *= 4) {
+        unsigned stride = sampleCount / (m * 4);
+        for (unsigned k = 0; k < m; k++) {
+            _multipliers.push_back(roots[k * stride]);
+            _multipliers.push_back(roots[2 * k * stride]);
+            _multipliers.push_back(roots[3 * k * stride]);
+        }
+    }
+}
+
+void Radix4Fft::compute(const float *samples, std::complex<float> *result) {
+    unsigned N = sampleCount();
+
+    // Load the samples in bit-reversed order, windowed on the way, then work in place
+    const float *window = windowCoefficients();
+    if (window) {
+        _reversal.copy(samples, window, result);
+    }
+    else {
+        _reversal.copy(samples, result);
+    }
+
+    unsigned m = 1;
+    if (_log2sc % 2) {
+        // Radix-2 tail, no multiplications needed for DFTs of size 2
+        for (unsigned i = 0; i < N; i += 2) {
+            auto u = result[i];
+            auto v = result[i + 1];
+            result[i] = u + v;
+            result[i + 1] = u - v;
+        }
+        m = 2;
+    }
+
+    const std::complex<float> *w = _multipliers.data();
+    for (; m * 4 <= N; w += 3 * m, m *= 4) {
+        for (unsigned a = 0; a < N; a += m * 4) {
+            // In bit-reversed order the four DFTs of the block are the ones
+            // of the samples with index 0, 2, 1, 3 (mod 4)
+            std::complex<float> *x0 = result + a;
+            std::complex<float> *x2 = x0 + m;
+            std::complex<float> *x1 = x2 + m;
+            std::complex<float> *x3 = x1 + m;
+
+            for (unsigned k = 0; k < m; k++) {
+                auto a0 = x0[k];
+                auto a1 = multiply(x1[k], w[3 * k]);
+                auto a2 = multiply(x2[k], w[3 * k + 1]);
+                auto a3 = multiply(x3[k], w[3 * k + 2]);
+
+                auto s02 = a0 + a2;
+                auto d02 = a0 - a2;
+                auto s13 = a1 + a3;
+                auto d13 = a1 - a3;
+                // -j * d13
+                auto jd13 = std::complex<float>(d13.imag(), -d13.real());
+
+                x0[k] = s02 + s13;
+                x2[k] = d02 + jd13;
+                x1[k] = s02 - s13;
+                x3[k] = d02 - jd13;
+            }
+        }
+    }
+}
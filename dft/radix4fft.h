@@ -0,0 +1,40 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef RADIX4FFT_H
+#define RADIX4FFT_H
+
+#include "dft.h"
+#include "twiddletable.h"
+#include "bitreversal.h"
+
+// Radix-4 decimation in time FFT.
+// Every pass combines four DFTs with 3 complex multiplications per 4 values,
+// so it does half as many passes over the data as Radix2Fft.
+// When log2(N) is odd a single radix-2 pass is done first.
+class Radix4Fft final : public Dft {
+private:
+    unsigned _log2sc;
+    BitReversal _reversal;
+    AlignedVector<std::complex<float> > _multipliers;
+
+public:
+    explicit Radix4Fft(unsigned sampleCount);
+
+    using Dft::compute;
+    void compute(const float *samples, std::complex<float> *result);
+};
+
+#endif // RADIX4FFT_H
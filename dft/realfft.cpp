@@ -0,0 +1,63 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <iostream>
+#include <map>
+#include <mutex>
+#include "realfft.h"
+
+static inline unsigned checkedLength(unsigned sampleCount) {
+    if (sampleCount == 0 || (sampleCount & (sampleCount - 1)) != 0) {
+        std::cout << "sample count should be a power of 2, but it's " << sampleCount << std::endl;
+        throw std::exception();
+    }
+    return sampleCount;
+}
+
+RealFft::RealFft(unsigned sampleCount) : Dft(sampleCount, sampleCount / 2 + 1), _fft(tablesForSize(checkedLength(sampleCount))) {
+    // Packed output, then the ffft scratch buffer
+    workspace().resize(2 * sampleCount, 0);
+}
+
+std::shared_ptr<const RealFft::Tables> RealFft::tablesForSize(unsigned sampleCount) {
+    static std::mutex mutex;
+    static std::map<unsigned, std::weak_ptr<const Tables> > registry;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const Tables> tables = registry[sampleCount].lock();
+    if (!tables) {
+        tables = std::make_shared<const Tables>(long(sampleCount));
+        registry[sampleCount] = tables;
+    }
+
+    return tables;
+}
+
+void RealFft::compute(const float *samples, std::complex<float> *result) {
+    float *packed = workspace().real();
+    _fft->do_fft(packed, samples, windowCoefficients(), packed + sampleCount());
+    unpack(packed, sampleCount(), result);
+}
+
+void RealFft::unpack(const float *packed, unsigned sampleCount, std::complex<float> *result) {
+    // FFTReal puts the real parts into [0, N/2] and the negated imaginary
+    // parts of bins 1 ... N/2-1 into [N/2+1, N)
+    unsigned half = sampleCount / 2;
+    result[0] = packed[0];
+    for (unsigned i = 1; i < half; i++) {
+        result[i] = std::complex<float>(packed[i], -packed[half + i]);
+    }
+    result[half] = packed[half];
+}
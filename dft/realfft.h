@@ -0,0 +1,50 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef REALFFT_H
+#define REALFFT_H
+
+#include <memory>
+#include "dft.h"
+#include "ffft/FFTReal.h"
+
+// FFT of purely real samples, based on ffft::FFTReal.
+// Only the N/2 + 1 non-redundant bins are computed, the rest would be
+// the complex conjugates of these.
+// The ffft tables are shared by every RealFft of the same size, the
+// scratch of the transform lives in the workspace of each engine.
+class RealFft final : public Dft {
+public:
+    typedef ffft::FFTReal<float> Tables;
+
+private:
+    std::shared_ptr<const Tables> _fft;
+
+public:
+    explicit RealFft(unsigned sampleCount);
+
+    // Returns the shared ffft object for the given size, creating it on
+    // first use. Only call its thread-safe do_fft / do_ifft overloads that
+    // take a scratch buffer.
+    static std::shared_ptr<const Tables> tablesForSize(unsigned sampleCount);
+
+    using Dft::compute;
+    void compute(const float *samples, std::complex<float> *result);
+
+    // Converts the packed output of ffft into the N/2 + 1 complex bins
+    static void unpack(const float *packed, unsigned sampleCount, std::complex<float> *result);
+};
+
+#endif // REALFFT_H
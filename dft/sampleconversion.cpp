@@ -0,0 +1,66 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include "sampleconversion.h"
+#include "cpufeatures.h"
+
+#if defined(SIMD_X86)
+#include <immintrin.h>
+
+// Each variant returns how many samples it converted, the plain loop does the rest
+
+SIMD_TARGET_SSE2 static unsigned convertSse2(const int16_t *in, float *out, unsigned count) {
+    unsigned i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        // Each int16 in the high half of an int32, then an arithmetic shift sign-extends it
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+        _mm_storeu_ps(out + i, _mm_cvtepi32_ps(lo));
+        _mm_storeu_ps(out + i + 4, _mm_cvtepi32_ps(hi));
+    }
+    return i;
+}
+
+SIMD_TARGET_AVX2 static unsigned convertAvx2(const int16_t *in, float *out, unsigned count) {
+    unsigned i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 8)));
+        _mm256_storeu_ps(out + i, _mm256_cvtepi32_ps(lo));
+        _mm256_storeu_ps(out + i + 8, _mm256_cvtepi32_ps(hi));
+    }
+    return i;
+}
+
+#endif
+
+void convertSamples(const int16_t *in, float *out, unsigned count) {
+    unsigned i = 0;
+
+#if defined(SIMD_X86)
+    static const SimdLevel level = simdLevel();
+    if (level >= SimdLevel::Avx2) {
+        i = convertAvx2(in, out, count);
+    }
+    else if (level >= SimdLevel::Sse2) {
+        i = convertSse2(in, out, count);
+    }
+#endif
+
+    for (; i < count; i++) {
+        out[i] = float(in[i]);
+    }
+}
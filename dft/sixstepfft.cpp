@@ -0,0 +1,148 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "sixstepfft.h"
+
+// Tiles of 32 x 32 complex values (8 KiB) stay in L1 during the transposes
+static const unsigned tileSize = 32;
+
+static unsigned log2Of(unsigned sampleCount) {
+    if (sampleCount < 4 || (sampleCount & (sampleCount - 1)) != 0) {
+        std::cout << "sample count should be a power of 2 (at least 4), but it's " << sampleCount << std::endl;
+        throw std::exception();
+    }
+
+    unsigned log2sc = 0;
+    while ((1u << log2sc) < sampleCount) {
+        log2sc++;
+    }
+    return log2sc;
+}
+
+SixStepFft::SixStepFft(unsigned sampleCount, int threadCount)
+    : Dft(sampleCount),
+      _n1(1u << (log2Of(sampleCount) / 2)),
+      _n2(sampleCount / _n1),
+      _rowFft(_n1),
+      _columnFft(_n2) {
+    const double pi = std::acos(-1.0);
+
+    // W_N^e = coarse[e >> fineBits] * fine[e & (fine size - 1)],
+    // two tables of about sqrt(N) values instead of N
+    _fineBits = (log2Of(sampleCount) + 1) / 2;
+    unsigned fineSize = 1u << _fineBits;
+    unsigned coarseSize = sampleCount / fineSize;
+
+    _fineTwiddles = AlignedVector<std::complex<float> >(fineSize);
+    for (unsigned i = 0; i < fineSize; i++) {
+        double phi = -2.0 * pi * i / sampleCount;
+        _fineTwiddles[i] = std::complex<float>(std::cos(phi), std::sin(phi));
+    }
+    _coarseTwiddles = AlignedVector<std::complex<float> >(coarseSize);
+    for (unsigned i = 0; i < coarseSize; i++) {
+        double phi = -2.0 * pi * ((double)i * fineSize) / sampleCount;
+        _coarseTwiddles[i] = std::complex<float>(std::cos(phi), std::sin(phi));
+    }
+
+    _pool.setMaxThreadCount(std::max(1, threadCount));
+    workspace().resize(0, 2 * sampleCount);
+}
+
+void SixStepFft::parallelFor(unsigned count, const std::function<void (unsigned, unsigned)> &body) {
+    unsigned chunks = std::min(count, (unsigned)_pool.maxThreadCount());
+    if (chunks <= 1) {
+        body(0, count);
+        return;
+    }
+
+    // The calling thread does the first chunk itself
+    for (unsigned c = 1; c < chunks; c++) {
+        unsigned begin = count * c / chunks;
+        unsigned end = count * (c + 1) / chunks;
+        _pool.start([&body, begin, end]() { body(begin, end); });
+    }
+    body(0, count / chunks);
+    _pool.waitForDone();
+}
+
+void SixStepFft::compute(const float *samples, std::complex<float> *result) {
+    const unsigned N1 = _n1, N2 = _n2;
+    std::complex<float> *a = workspace().complex();
+    std::complex<float> *b = a + sampleCount();
+    const float *window = windowCoefficients();
+
+    // 1. a[n2][n1] = x[N2 * n1 + n2] (times the window), the columns of x become rows
+    parallelFor(N1 / std::min(N1, tileSize), [&](unsigned begin, unsigned end) {
+        const unsigned tile = std::min(N1, tileSize);
+        for (unsigned n1t = begin * tile; n1t < end * tile; n1t += tile) {
+            for (unsigned n2t = 0; n2t < N2; n2t += tile) {
+                for (unsigned n1 = n1t; n1 < n1t + tile; n1++) {
+                    for (unsigned n2 = n2t; n2 < n2t + tile; n2++) {
+                        const unsigned n = N2 * n1 + n2;
+                        a[n2 * N1 + n1] = window ? samples[n] * window[n] : samples[n];
+                    }
+                }
+            }
+        }
+    });
+
+    // 2. N2 FFTs of length N1
+    parallelFor(N2, [&](unsigned begin, unsigned end) {
+        for (unsigned n2 = begin; n2 < end; n2++) {
+            _rowFft.transform(a + n2 * N1);
+        }
+    });
+
+    // 3. b[k1][n2] = a[n2][k1] * W_N^(n2 * k1)
+    const unsigned fineMask = (1u << _fineBits) - 1;
+    parallelFor(N2 / std::min(N2, tileSize), [&](unsigned begin, unsigned end) {
+        const unsigned tile = std::min(N2, tileSize);
+        for (unsigned n2t = begin * tile; n2t < end * tile; n2t += tile) {
+            for (unsigned k1t = 0; k1t < N1; k1t += std::min(N1, tileSize)) {
+                for (unsigned n2 = n2t; n2 < n2t + tile; n2++) {
+                    for (unsigned k1 = k1t; k1 < k1t + std::min(N1, tileSize); k1++) {
+                        unsigned e = n2 * k1;
+                        std::complex<float> w = _coarseTwiddles[e >> _fineBits] * _fineTwiddles[e & fineMask];
+                        b[k1 * N2 + n2] = a[n2 * N1 + k1] * w;
+                    }
+                }
+            }
+        }
+    });
+
+    // 4. N1 FFTs of length N2
+    parallelFor(N1, [&](unsigned begin, unsigned end) {
+        for (unsigned k1 = begin; k1 < end; k1++) {
+            _columnFft.transform(b + k1 * N2);
+        }
+    });
+
+    // 5. X[k1 + N1 * k2] = b[k1][k2]
+    parallelFor(N1 / std::min(N1, tileSize), [&](unsigned begin, unsigned end) {
+        const unsigned tile = std::min(N1, tileSize);
+        for (unsigned k1t = begin * tile; k1t < end * tile; k1t += tile) {
+            for (unsigned k2t = 0; k2t < N2; k2t += std::min(N2, tileSize)) {
+                for (unsigned k1 = k1t; k1 < k1t + tile; k1++) {
+                    for (unsigned k2 = k2t; k2 < k2t + std::min(N2, tileSize); k2++) {
+                        result[k2 * N1 + k1] = b[k1 * N2 + k2];
+                    }
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,46 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef SIXSTEPFFT_H
+#define SIXSTEPFFT_H
+
+#include <functional>
+#include <QThreadPool>
+#include "dft.h"
+#include "radix2fft.h"
+
+// Six-step FFT for very large transforms (2^20 points and more).
+// N is seen as an N2 x N1 matrix, so that the transform becomes N2 FFTs of
+// length N1 and N1 FFTs of length N2 that fit in the cache, separated by
+// transposes done in small tiles. The twiddle multiplication is fused
+// into the middle transpose. Rows and tiles are spread over a thread pool.
+class SixStepFft final : public Dft {
+private:
+    unsigned _n1, _n2;
+    Radix2Fft _rowFft, _columnFft;
+    AlignedVector<std::complex<float> > _coarseTwiddles, _fineTwiddles;
+    unsigned _fineBits;
+    QThreadPool _pool;
+
+    void parallelFor(unsigned count, const std::function<void (unsigned, unsigned)> &body);
+
+public:
+    explicit SixStepFft(unsigned sampleCount, int threadCount = QThread::idealThreadCount());
+
+    using Dft::compute;
+    void compute(const float *samples, std::complex<float> *result);
+};
+
+#endif // SIXSTEPFFT_H
@@ -0,0 +1,333 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "slidingdft.h"
+#include "dftfactory.h"
+#include "cpufeatures.h"
+
+// Pending samples are applied in chunks of at most this many: the
+// recurrence of horner() multiplies by W^k once per sample, so its
+// rounding error grows with the chunk length, while every chunk costs a
+// rotation by the exact W^(k m) of the table.
+static const unsigned chunkLength = 32;
+
+#if defined(SIMD_X86)
+#include <immintrin.h>
+
+// Same as the loop of horner(), 4 vectors of 4 or 8 bins at a time:
+// each step depends on the previous one, so a single vector would wait
+// on its own latency. The vectors are spelled out to stay in registers.
+
+SIMD_TARGET_SSE2 static inline void hornerStepSse2(__m128 &ar, __m128 &ai, const float *stepReal, const float *stepImag, __m128 delta) {
+    const __m128 zr = _mm_load_ps(stepReal);
+    const __m128 zi = _mm_load_ps(stepImag);
+    const __m128 r = _mm_sub_ps(_mm_mul_ps(ar, zr), _mm_mul_ps(ai, zi));
+    ai = _mm_add_ps(_mm_mul_ps(ar, zi), _mm_mul_ps(ai, zr));
+    ar = _mm_add_ps(r, delta);
+}
+
+SIMD_TARGET_SSE2 static unsigned hornerSse2(const float *stepReal, const float *stepImag, const float *deltas, unsigned count, float *real, float *imag, unsigned binCount) {
+    unsigned k = 0;
+    for (; k + 16 <= binCount; k += 16) {
+        __m128 ar0 = _mm_set1_ps(deltas[count - 1]);
+        __m128 ar1 = ar0;
+        __m128 ar2 = ar0;
+        __m128 ar3 = ar0;
+        __m128 ai0 = _mm_setzero_ps();
+        __m128 ai1 = ai0;
+        __m128 ai2 = ai0;
+        __m128 ai3 = ai0;
+        for (unsigned s = count - 1; s-- > 0;) {
+            const __m128 delta = _mm_set1_ps(deltas[s]);
+            hornerStepSse2(ar0, ai0, stepReal + k, stepImag + k, delta);
+            hornerStepSse2(ar1, ai1, stepReal + k + 4, stepImag + k + 4, delta);
+            hornerStepSse2(ar2, ai2, stepReal + k + 8, stepImag + k + 8, delta);
+            hornerStepSse2(ar3, ai3, stepReal + k + 12, stepImag + k + 12, delta);
+        }
+        _mm_store_ps(real + k, ar0);
+        _mm_store_ps(real + k + 4, ar1);
+        _mm_store_ps(real + k + 8, ar2);
+        _mm_store_ps(real + k + 12, ar3);
+        _mm_store_ps(imag + k, ai0);
+        _mm_store_ps(imag + k + 4, ai1);
+        _mm_store_ps(imag + k + 8, ai2);
+        _mm_store_ps(imag + k + 12, ai3);
+    }
+    return k;
+}
+
+SIMD_TARGET_AVX2 static inline void hornerStepAvx2(__m256 &ar, __m256 &ai, const float *stepReal, const float *stepImag, __m256 delta) {
+    const __m256 zr = _mm256_load_ps(stepReal);
+    const __m256 zi = _mm256_load_ps(stepImag);
+    const __m256 r = _mm256_fmadd_ps(ar, zr, _mm256_fnmadd_ps(ai, zi, delta));
+    ai = _mm256_fmadd_ps(ar, zi, _mm256_mul_ps(ai, zr));
+    ar = r;
+}
+
+SIMD_TARGET_AVX2 static unsigned hornerAvx2(const float *stepReal, const float *stepImag, const float *deltas, unsigned count, float *real, float *imag, unsigned binCount) {
+    unsigned k = 0;
+    for (; k + 32 <= binCount; k += 32) {
+        __m256 ar0 = _mm256_set1_ps(deltas[count - 1]);
+        __m256 ar1 = ar0;
+        __m256 ar2 = ar0;
+        __m256 ar3 = ar0;
+        __m256 ai0 = _mm256_setzero_ps();
+        __m256 ai1 = ai0;
+        __m256 ai2 = ai0;
+        __m256 ai3 = ai0;
+        for (unsigned s = count - 1; s-- > 0;) {
+            const __m256 delta = _mm256_set1_ps(deltas[s]);
+            hornerStepAvx2(ar0, ai0, stepReal + k, stepImag + k, delta);
+            hornerStepAvx2(ar1, ai1, stepReal + k + 8, stepImag + k + 8, delta);
+            hornerStepAvx2(ar2, ai2, stepReal + k + 16, stepImag + k + 16, delta);
+            hornerStepAvx2(ar3, ai3, stepReal + k + 24, stepImag + k + 24, delta);
+        }
+        _mm256_store_ps(real + k, ar0);
+        _mm256_store_ps(real + k + 8, ar1);
+        _mm256_store_ps(real + k + 16, ar2);
+        _mm256_store_ps(real + k + 24, ar3);
+        _mm256_store_ps(imag + k, ai0);
+        _mm256_store_ps(imag + k + 8, ai1);
+        _mm256_store_ps(imag + k + 16, ai2);
+        _mm256_store_ps(imag + k + 24, ai3);
+    }
+    return k;
+}
+
+#endif
+
+// H_k = sum of deltas[s] * z_k^s over the count deltas, z_k = W^k, for every bin.
+// Horner's scheme, latest delta first: a complex multiply-add per bin and
+// sample on contiguous arrays, unlike the gathered W^(k m) of the table.
+static void horner(const float *stepReal, const float *stepImag, const float *deltas, unsigned count, float *real, float *imag, unsigned binCount) {
+    unsigned k = 0;
+
+#if defined(SIMD_X86)
+    static const SimdLevel level = simdLevel();
+    if (level >= SimdLevel::Avx2) {
+        k = hornerAvx2(stepReal, stepImag, deltas, count, real, imag, binCount);
+    }
+    else if (level >= SimdLevel::Sse2) {
+        k = hornerSse2(stepReal, stepImag, deltas, count, real, imag, binCount);
+    }
+#endif
+
+    // Sample after sample over the remaining bins, which are independent
+    const unsigned first = k;
+    for (k = first; k < binCount; k++) {
+        real[k] = deltas[count - 1];
+        imag[k] = 0.0f;
+    }
+    for (unsigned s = count - 1; s-- > 0;) {
+        const float delta = deltas[s];
+        for (k = first; k < binCount; k++) {
+            const float r = real[k] * stepReal[k] - imag[k] * stepImag[k] + delta;
+            imag[k] = real[k] * stepImag[k] + imag[k] * stepReal[k];
+            real[k] = r;
+        }
+    }
+}
+
+// Bins per step of horner(), for defaultMaxPending()
+static unsigned hornerLanes() {
+#if defined(SIMD_X86)
+    if (simdLevel() >= SimdLevel::Avx2) {
+        return 8;
+    }
+    if (simdLevel() >= SimdLevel::Sse2) {
+        return 4;
+    }
+#endif
+    return 1;
+}
+
+unsigned SlidingDft::defaultMaxPending(unsigned sampleCount) {
+    // N log2 N for the FFT against (N / 2) * 2 / lanes per sample: the
+    // complex multiply-add is twice the work of an FFT operation
+    unsigned log2 = 0;
+    while ((2u << log2) <= sampleCount) {
+        log2++;
+    }
+    return std::max(1u, std::min(hornerLanes() * log2, sampleCount));
+}
+
+SlidingDft::SlidingDft(unsigned sampleCount, unsigned resyncInterval, unsigned maxPending)
+    : _sampleCount(sampleCount),
+      _resyncInterval(resyncInterval ? resyncInterval : sampleCount),
+      _maxPending(1),
+      _position(0),
+      _sinceResync(0),
+      _dft(nullptr),
+      _window(sampleCount, 0.0f),
+      _twiddles(sampleCount),
+      _bins(sampleCount / 2 + 1),
+      _pending(0) {
+    if (sampleCount < 2) {
+        std::cout << "sliding DFT needs at least 2 samples, but it has " << sampleCount << std::endl;
+        throw std::exception();
+    }
+
+    // W^j = e^(-2 pi i j / N), computed in double so that the table itself adds no drift
+    const double pi = std::acos(-1.0);
+    for (unsigned j = 0; j < sampleCount; j++) {
+        _twiddles[j] = std::complex<float>(std::polar(1.0, -2.0 * pi * j / sampleCount));
+    }
+
+    // W^k of every bin in two arrays, the steps of horner()
+    const unsigned binCount = sampleCount / 2 + 1;
+    _stepReal.resize(binCount);
+    _stepImag.resize(binCount);
+    for (unsigned k = 0; k < binCount; k++) {
+        _stepReal[k] = _twiddles[k].real();
+        _stepImag[k] = _twiddles[k].imag();
+    }
+    _chunkReal.resize(binCount);
+    _chunkImag.resize(binCount);
+
+    // Its result has N/2 + 1 or N bins, resync() only uses the first N/2 + 1
+    _dft = DftFactory::create(sampleCount);
+    _ordered.resize(sampleCount);
+    _exact.resize(_dft->binCount());
+
+    // After N samples the whole window is new anyway
+    _maxPending = std::min(maxPending ? maxPending : defaultMaxPending(sampleCount), sampleCount);
+    _deltas.resize(_maxPending);
+    reset();
+}
+
+SlidingDft::~SlidingDft() {
+    delete _dft;
+}
+
+void SlidingDft::reset() {
+    std::fill(_window.begin(), _window.end(), 0.0f);
+    std::fill(_bins.begin(), _bins.end(), std::complex<float>(0.0f, 0.0f));
+    _position = 0;
+    _sinceResync = 0;
+    _pending = 0;
+}
+
+void SlidingDft::push(const float *samples, unsigned count) {
+    const unsigned N = _sampleCount;
+
+    for (unsigned s = 0; s < count; s++) {
+        if (_pending < _maxPending) {
+            _deltas[_pending] = samples[s] - _window[_position];
+        }
+        _pending = std::min(_pending + 1, _maxPending + 1);
+        _window[_position] = samples[s];
+        _position = (_position + 1 == N) ? 0 : _position + 1;
+    }
+}
+
+void SlidingDft::update() {
+    if (_pending == 0) {
+        return;
+    }
+    if (_pending > _maxPending || _sinceResync + _pending >= _resyncInterval) {
+        resync();
+        return;
+    }
+
+    slide();
+}
+
+void SlidingDft::slide() {
+    const unsigned N = _sampleCount;
+    const unsigned binCount = N / 2 + 1;
+    std::complex<float> *bins = _bins.data();
+    const std::complex<float> *twiddles = _twiddles.data();
+    const float *real = _chunkReal.data();
+    const float *imag = _chunkImag.data();
+
+    // With m the position of the first sample of a chunk:
+    // Y_k += sum of (x(n) - x(n - N)) * W^(k (m + s)) = W^(k m) * H_k
+    unsigned m = (_position + N - _pending) % N;
+    for (unsigned first = 0; first < _pending; first += chunkLength) {
+        const unsigned count = std::min(chunkLength, _pending - first);
+        horner(_stepReal.data(), _stepImag.data(), &_deltas[first], count, _chunkReal.data(), _chunkImag.data(), binCount);
+
+        // The index k m mod N is stepped instead of multiplied
+        unsigned index = 0;
+        for (unsigned k = 0; k < binCount; k++) {
+            const std::complex<float> w = twiddles[index];
+            bins[k] += std::complex<float>(real[k] * w.real() - imag[k] * w.imag(), real[k] * w.imag() + imag[k] * w.real());
+            index += m;
+            if (index >= N) {
+                index -= N;
+            }
+        }
+
+        m = (m + count) % N;
+    }
+
+    _sinceResync += _pending;
+    _pending = 0;
+}
+
+void SlidingDft::spectrum(std::complex<float> *result) {
+    update();
+
+    // X_k = Y_k * W^(-k (n + 1)), and n + 1 = _position mod N
+    const unsigned N = _sampleCount;
+    unsigned index = 0;
+    for (unsigned k = 0; k < N / 2 + 1; k++) {
+        result[k] = _bins[k] * std::conj(_twiddles[index]);
+        index += _position;
+        if (index >= N) {
+            index -= N;
+        }
+    }
+}
+
+void SlidingDft::spectrum(float *real, float *imag) {
+    update();
+
+    const unsigned N = _sampleCount;
+    unsigned index = 0;
+    for (unsigned k = 0; k < N / 2 + 1; k++) {
+        std::complex<float> bin = _bins[k] * std::conj(_twiddles[index]);
+        real[k] = bin.real();
+        imag[k] = bin.imag();
+        index += _position;
+        if (index >= N) {
+            index -= N;
+        }
+    }
+}
+
+void SlidingDft::resync() {
+    const unsigned N = _sampleCount;
+    _sinceResync = 0;
+    _pending = 0;
+
+    // Exact spectrum of the window in time order, oldest sample first
+    std::copy(_window.begin() + _position, _window.end(), _ordered.begin());
+    std::copy(_window.begin(), _window.begin() + _position, _ordered.begin() + (N - _position));
+    _dft->compute(_ordered.data(), _exact.data());
+
+    // Back into the rotating frame: Y_k = X_k * W^(k (n + 1))
+    unsigned index = 0;
+    for (unsigned k = 0; k < N / 2 + 1; k++) {
+        _bins[k] = _exact[k] * _twiddles[index];
+        index += _position;
+        if (index >= N) {
+            index -= N;
+        }
+    }
+}
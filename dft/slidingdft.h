@@ -0,0 +1,92 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef SLIDINGDFT_H
+#define SLIDINGDFT_H
+
+#include "dft.h"
+
+// Sliding DFT of the last N real samples, so that a fresh spectrum is
+// available every few samples instead of once per frame.
+// It's the modulated variant (mSDFT): the bins are kept in a rotating frame
+// and each sample adds (new - oldest) * W^(k m) to them, O(N) per sample,
+// with no recursive twiddle multiplication that would make float errors grow.
+// Samples are only applied when the spectrum is read, a chunk of them at a
+// time with a vectorized Horner recurrence on every bin (see slide()).
+// That is still O(N) per sample: when more samples are pending than an FFT
+// is worth, the bins are recomputed exactly with an FFT instead, which also
+// removes the rounding noise that piles up. See defaultMaxPending() for that
+// count: around 64 to 112 samples from N = 256 to 16384 with AVX2, half as
+// many with SSE2. Reading the spectrum less often than that, every read is a
+// full FFT, and the sliding DFT is no faster than computing every hop from
+// scratch.
+// The bins are also resynced every resyncInterval samples at the latest.
+// Like the real FFT engines, only the N/2 + 1 non-redundant bins are kept.
+class SlidingDft {
+private:
+    unsigned _sampleCount;
+    unsigned _resyncInterval;
+    unsigned _maxPending;
+    unsigned _position;
+    unsigned _sinceResync;
+    Dft *_dft;
+    AlignedVector<float> _window;
+    AlignedVector<std::complex<float> > _twiddles;
+    AlignedVector<std::complex<float> > _bins;
+    // W^k of the bins, and the sums of a chunk of samples, see slide()
+    AlignedVector<float> _stepReal;
+    AlignedVector<float> _stepImag;
+    AlignedVector<float> _chunkReal;
+    AlignedVector<float> _chunkImag;
+    // x(n) - x(n - N) of the samples pushed since the last update, or
+    // more than _maxPending if the bins have to be recomputed
+    AlignedVector<float> _deltas;
+    unsigned _pending;
+    // resync() buffers
+    AlignedVector<float> _ordered;
+    AlignedVector<std::complex<float> > _exact;
+
+    void update();
+    void slide();
+    void resync();
+
+public:
+    // resyncInterval = 0 resyncs once every sampleCount samples,
+    // maxPending = 0 takes defaultMaxPending(sampleCount)
+    explicit SlidingDft(unsigned sampleCount, unsigned resyncInterval = 0, unsigned maxPending = 0);
+    ~SlidingDft();
+
+    // Most samples applied incrementally at a read, from operation counts:
+    // an FFT costs about N log2 N operations, and each sample a complex
+    // multiply-add per bin, N / 2 bins spread over the vector lanes of
+    // slide() (8 with AVX2, 4 with SSE2). Deterministic, unlike a timing.
+    static unsigned defaultMaxPending(unsigned sampleCount);
+
+    unsigned sampleCount() { return _sampleCount; }
+    unsigned binCount() { return _sampleCount / 2 + 1; }
+    unsigned maxPending() { return _maxPending; }
+
+    void push(const float *samples, unsigned count);
+
+    // Unnormalized spectrum of the last sampleCount samples, same layouts as
+    // the output of Dft::compute and Dft::computeSplit: binCount() bins
+    void spectrum(std::complex<float> *result);
+    void spectrum(float *real, float *imag);
+
+    // Forgets every sample, the window is filled with zeros
+    void reset();
+};
+
+#endif // SLIDINGDFT_H
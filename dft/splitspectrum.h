@@ -0,0 +1,92 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef SPLITSPECTRUM_H
+#define SPLITSPECTRUM_H
+
+#include <complex>
+#include "alignedallocator.h"
+
+// Spectrum with the real and imaginary parts in two separate arrays.
+// Per-bin loops (power, magnitude, smoothing...) then read plain float
+// arrays, and vectorize without shuffling the interleaved (re, im) pairs
+// of std::complex apart. See BasicDft::computeSplit.
+
+// real[k] = bins[k].real(), imag[k] = bins[k].imag()
+template <typename T>
+inline void deinterleave(const std::complex<T> *bins, T *real, T *imag, unsigned count) {
+    const T *b = reinterpret_cast<const T *>(bins);
+    for (unsigned k = 0; k < count; k++) {
+        real[k] = b[2 * k];
+        imag[k] = b[2 * k + 1];
+    }
+}
+
+// bins[k] = (real[k], imag[k])
+template <typename T>
+inline void interleave(const T *real, const T *imag, std::complex<T> *bins, unsigned count) {
+    T *b = reinterpret_cast<T *>(bins);
+    for (unsigned k = 0; k < count; k++) {
+        b[2 * k] = real[k];
+        b[2 * k + 1] = imag[k];
+    }
+}
+
+template <typename T>
+class BasicSplitSpectrum {
+private:
+    AlignedVector<T> _real;
+    AlignedVector<T> _imag;
+
+public:
+    inline BasicSplitSpectrum() { }
+
+    explicit inline BasicSplitSpectrum(unsigned count) : _real(count), _imag(count) { }
+
+    inline void resize(unsigned count) {
+        _real.resize(count);
+        _imag.resize(count);
+    }
+
+    inline unsigned size() {
+        return unsigned(_real.size());
+    }
+
+    inline T *real() {
+        return _real.data();
+    }
+
+    inline T *imag() {
+        return _imag.data();
+    }
+
+    inline std::complex<T> operator[](unsigned k) {
+        return std::complex<T>(_real[k], _imag[k]);
+    }
+
+    // Conversions for code that works with interleaved bins
+    inline void assign(const std::complex<T> *bins, unsigned count) {
+        resize(count);
+        deinterleave(bins, real(), imag(), count);
+    }
+
+    inline void copyTo(std::complex<T> *bins) {
+        interleave(real(), imag(), bins, size());
+    }
+};
+
+typedef BasicSplitSpectrum<float> SplitSpectrum;
+
+#endif // SPLITSPECTRUM_H
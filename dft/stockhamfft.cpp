@@ -0,0 +1,215 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <iostream>
+#include "stockhamfft.h"
+
+// Plain complex product, without the NaN/infinity recovery of operator*
+static inline std::complex<float> multiply(std::complex<float> a, std::complex<float> b) {
+    return std::complex<float>(a.real() * b.real() - a.imag() * b.imag(),
+                               a.real() * b.imag() + a.imag() * b.real());
+}
+
+StockhamFft::StockhamFft(unsigned sampleCount) : Dft(sampleCount) {
+    if (sampleCount == 0 || (sampleCount & (sampleCount - 1)) != 0) {
+        std::cout << "sample count should be a power of 2, but it's " << sampleCount << std::endl;
+        throw std::exception();
+    }
+
+    _log2sc = 0;
+    while ((1u << _log2sc) < sampleCount) {
+        _log2sc++;
+    }
+
+    // The pass on DFTs of size n = 4m needs w^p, w^2p, w^3p for every p < m,
+    // where w = exp(-2πj / n). They are stored pass after pass, in the order
+    // compute() uses them.
+    _twiddles = TwiddleTable::forSize(sampleCount);
+    const std::complex<float> *roots = _twiddles->roots();
+    unsigned n = (_log2sc % 2) ? sampleCount / 2 : sampleCount;
+    for (; n >= 4; n /= 4) {
+        unsigned stride = sampleCount / n;
+        for (unsigned p = 0; p < n / 4; p++) {
+            _multipliers.push_back(roots[p * stride]);
+            _multipliers.push_back(roots[2 * p * stride]);
+            _multipliers.push_back(roots[3 * p * stride]);
+        }
+    }
+
+    workspace().resize(0, sampleCount);
+}
+
+// Where a pass writes: interleaved bins (the ping-pong buffers and
+// compute()'s result), or the two arrays of computeSplit()
+struct InterleavedOutput {
+    std::complex<float> *data;
+
+    inline void store(unsigned i, std::complex<float> value) {
+        data[i] = value;
+    }
+};
+
+struct SplitOutput {
+    float *real;
+    float *imag;
+
+    inline void store(unsigned i, std::complex<float> value) {
+        real[i] = value.real();
+        imag[i] = value.imag();
+    }
+};
+
+// What the first pass reads when there is a window: the samples multiplied
+// by it as they are loaded. Indexes and offsets like the plain sample pointer.
+struct WindowedInput {
+    const float *samples;
+    const float *window;
+
+    inline float operator[](unsigned i) const {
+        return samples[i] * window[i];
+    }
+
+    inline WindowedInput operator+(unsigned offset) const {
+        return WindowedInput{samples + offset, window + offset};
+    }
+};
+
+// Radix-2 pass on the whole input:
+//   y[2p] = x[p] + x[p + m], y[2p + 1] = (x[p] - x[p + m]) * exp(-2πjp / N)
+template <typename In, typename Out>
+static inline void radix2Pass(In x, Out y, unsigned m, const std::complex<float> *roots) {
+    for (unsigned p = 0; p < m; p++) {
+        float a = x[p];
+        float b = x[p + m];
+        y.store(2 * p, a + b);
+        y.store(2 * p + 1, roots[p] * (a - b));
+    }
+}
+
+// One pass turns the DFTs of size n = 4m, interleaved with stride s,
+// into DFTs of size m with stride 4s. With a_k = x[q + s(p + km)]:
+//   y[q + s(4p)]     =  (a0 + a2) + (a1 + a3)
+//   y[q + s(4p + 1)] = ((a0 - a2) - j(a1 - a3)) * w^p
+//   y[q + s(4p + 2)] = ((a0 + a2) - (a1 + a3)) * w^2p
+//   y[q + s(4p + 3)] = ((a0 - a2) + j(a1 - a3)) * w^3p
+// For a given p both the reads and the writes are runs of s contiguous values.
+template <typename In, typename Out>
+static inline void radix4Pass(In x, Out y, unsigned m, unsigned s, const std::complex<float> *w) {
+    for (unsigned p = 0; p < m; p++) {
+        In x0 = x + s * p;
+        In x1 = x0 + s * m;
+        In x2 = x1 + s * m;
+        In x3 = x2 + s * m;
+        const unsigned y0 = s * 4 * p;
+        const unsigned y1 = y0 + s;
+        const unsigned y2 = y1 + s;
+        const unsigned y3 = y2 + s;
+        std::complex<float> w1 = w[3 * p];
+        std::complex<float> w2 = w[3 * p + 1];
+        std::complex<float> w3 = w[3 * p + 2];
+
+        for (unsigned q = 0; q < s; q++) {
+            std::complex<float> a0 = x0[q];
+            std::complex<float> a1 = x1[q];
+            std::complex<float> a2 = x2[q];
+            std::complex<float> a3 = x3[q];
+
+            auto s02 = a0 + a2;
+            auto d02 = a0 - a2;
+            auto s13 = a1 + a3;
+            auto d13 = a1 - a3;
+            // -j * d13
+            auto jd13 = std::complex<float>(d13.imag(), -d13.real());
+
+            y.store(y0 + q, s02 + s13);
+            y.store(y1 + q, multiply(d02 + jd13, w1));
+            y.store(y2 + q, multiply(s02 - s13, w2));
+            y.store(y3 + q, multiply(d02 - jd13, w3));
+        }
+    }
+}
+
+// Every pass but the last goes from x to y and swaps them, the last one writes 'out'.
+// The first pass reads the real samples directly, windowed through
+// WindowedInput if need be, so there is no load pass.
+template <typename In, typename Out>
+void StockhamFft::passes(In samples, std::complex<float> *x, std::complex<float> *y, Out out) {
+    unsigned N = sampleCount();
+
+    if (N == 1) {
+        out.store(0, samples[0]);
+        return;
+    }
+
+    const std::complex<float> *w = _multipliers.data();
+    unsigned s;
+
+    if (_log2sc % 2) {
+        if (N == 2) {
+            radix2Pass(samples, out, 1, _twiddles->roots());
+            return;
+        }
+        radix2Pass(samples, InterleavedOutput{x}, N / 2, _twiddles->roots());
+        s = 2;
+    }
+    else {
+        unsigned m = N / 4;
+        if (N == 4) {
+            radix4Pass(samples, out, m, 1, w);
+            return;
+        }
+        radix4Pass(samples, InterleavedOutput{x}, m, 1, w);
+        w += 3 * m;
+        s = 4;
+    }
+
+    for (; s * 4 < N; s *= 4) {
+        unsigned m = N / (s * 4);
+        radix4Pass(x, InterleavedOutput{y}, m, s, w);
+        w += 3 * m;
+        std::swap(x, y);
+    }
+    radix4Pass(x, out, 1, s, w);
+}
+
+void StockhamFft::compute(const float *samples, std::complex<float> *result) {
+    // Start in the buffer that makes the last pass read the workspace:
+    // Stockham passes can't work in place
+    unsigned count = (_log2sc + 1) / 2;
+    std::complex<float> *x = (count % 2) ? result : workspace().complex();
+    std::complex<float> *y = (count % 2) ? workspace().complex() : result;
+    const float *window = windowCoefficients();
+    if (window) {
+        passes(WindowedInput{samples, window}, x, y, InterleavedOutput{result});
+    }
+    else {
+        passes(samples, x, y, InterleavedOutput{result});
+    }
+}
+
+void StockhamFft::computeSplit(const float *samples, float *real, float *imag) {
+    // The result can't be a ping-pong buffer here, so a second one is needed.
+    // Allocated on the first call only, most engines never see one
+    if (_split.empty()) {
+        _split.resize(sampleCount());
+    }
+    const float *window = windowCoefficients();
+    if (window) {
+        passes(WindowedInput{samples, window}, workspace().complex(), _split.data(), SplitOutput{real, imag});
+    }
+    else {
+        passes(samples, workspace().complex(), _split.data(), SplitOutput{real, imag});
+    }
+}
@@ -0,0 +1,51 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef STOCKHAMFFT_H
+#define STOCKHAMFFT_H
+
+#include "dft.h"
+#include "twiddletable.h"
+
+// Stockham autosort FFT, radix 4, decimation in frequency.
+// Every pass reads one buffer and writes the other, so the output comes
+// out in natural order without a bit-reversal permutation, and every
+// pass only walks its buffers sequentially. This keeps large sizes
+// (64k and up) from thrashing the cache with the scattered load.
+// When log2(N) is odd the first pass is a radix-2 one.
+// Its last pass can write a split spectrum directly, see computeSplit().
+class StockhamFft final : public Dft {
+private:
+    unsigned _log2sc;
+    std::shared_ptr<const TwiddleTable> _twiddles;
+    // Multipliers of every radix-4 pass, w^p, w^2p, w^3p for every p
+    AlignedVector<std::complex<float> > _multipliers;
+    // Second ping-pong buffer of computeSplit()
+    AlignedVector<std::complex<float> > _split;
+
+    template <typename In, typename Out>
+    void passes(In samples, std::complex<float> *x, std::complex<float> *y, Out out);
+
+public:
+    explicit StockhamFft(unsigned sampleCount);
+
+    using Dft::compute;
+    void compute(const float *samples, std::complex<float> *result);
+
+    // The last pass writes the two arrays directly
+    void computeSplit(const float *samples, float *real, float *imag);
+};
+
+#endif // STOCKHAMFFT_H
@@ -0,0 +1,60 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include "twiddletable.h"
+#include <cmath>
+#include <map>
+#include <mutex>
+
+template <typename T>
+BasicTwiddleTable<T>::BasicTwiddleTable(unsigned size) : _size(size) {
+    const double pi = std::acos(-1.0);
+
+    _roots = AlignedVector<std::complex<T> >(size);
+    for (unsigned k = 0; k < size; k++) {
+        double phi = -2.0 * pi * k / size;
+        _roots[k] = std::complex<T>(std::cos(phi), std::sin(phi));
+    }
+
+    // Every stage is a strided subset of the roots, but the butterflies are
+    // much happier reading them contiguously, so lay them out stage by stage.
+    if (size >= 2 && (size & (size - 1)) == 0) {
+        _stages = AlignedVector<std::complex<T> >(size);
+        for (unsigned half = 1; half < size; half *= 2) {
+            for (unsigned b = 0; b < half; b++) {
+                _stages[half + b] = _roots[b * (size / (half * 2))];
+            }
+        }
+    }
+}
+
+template <typename T>
+std::shared_ptr<const BasicTwiddleTable<T> > BasicTwiddleTable<T>::forSize(unsigned size) {
+    // One registry per precision
+    static std::mutex mutex;
+    static std::map<unsigned, std::weak_ptr<const BasicTwiddleTable> > registry;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const BasicTwiddleTable> table = registry[size].lock();
+    if (!table) {
+        table = std::make_shared<const BasicTwiddleTable>(size);
+        registry[size] = table;
+    }
+
+    return table;
+}
+
+template class BasicTwiddleTable<float>;
+template class BasicTwiddleTable<double>;
@@ -0,0 +1,57 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef TWIDDLETABLE_H
+#define TWIDDLETABLE_H
+
+#include <complex>
+#include <memory>
+#include "alignedallocator.h"
+
+// Read-only table of the complex roots of unity used by the transforms.
+// Tables are shared between every engine of the same size and precision,
+// use forSize() to get one.
+template <typename T>
+class BasicTwiddleTable final {
+private:
+    unsigned _size;
+    AlignedVector<std::complex<T> > _roots;
+    AlignedVector<std::complex<T> > _stages;
+
+public:
+    explicit BasicTwiddleTable(unsigned size);
+
+    inline unsigned size() const {
+        return _size;
+    }
+
+    // exp(-2πjk/N) for every k in [0, N)
+    inline const std::complex<T> *roots() const {
+        return _roots.data();
+    }
+
+    // Multipliers of the radix-2 stage that combines DFTs of size 'half',
+    // stored contiguously: exp(-πjb/half) for every b in [0, half).
+    // Only available when the size is a power of 2.
+    inline const std::complex<T> *stage(unsigned half) const {
+        return _stages.data() + half;
+    }
+
+    static std::shared_ptr<const BasicTwiddleTable> forSize(unsigned size);
+};
+
+typedef BasicTwiddleTable<float> TwiddleTable;
+
+#endif // TWIDDLETABLE_H
@@ -0,0 +1,134 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include "windowtable.h"
+
+static const struct {
+    WindowType type;
+    const char *name;
+} windowNames[] = {
+    { WindowType::Rectangular, "rectangular" },
+    { WindowType::Hann, "hann" },
+    { WindowType::BlackmanHarris, "blackman-harris" },
+    { WindowType::FlatTop, "flat-top" },
+    { WindowType::Kaiser, "kaiser" }
+};
+
+const char *windowName(WindowType type) {
+    for (const auto &entry : windowNames) {
+        if (entry.type == type) {
+            return entry.name;
+        }
+    }
+    return "";
+}
+
+WindowType windowTypeByName(const char *name) {
+    for (const auto &entry : windowNames) {
+        if (std::strcmp(entry.name, name) == 0) {
+            return entry.type;
+        }
+    }
+    return WindowType::Rectangular;
+}
+
+// Sum of a_k cos(2 pi k n / N) with alternating signs
+static double cosineSum(const double *a, unsigned terms, double phase) {
+    double result = 0.0;
+    double sign = 1.0;
+    for (unsigned k = 0; k < terms; k++) {
+        result += sign * a[k] * std::cos(k * phase);
+        sign = -sign;
+    }
+    return result;
+}
+
+// Modified Bessel function of the first kind, order 0, from its power series
+static double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double q = x * x / 4.0;
+    for (unsigned k = 1; k < 64 && term > sum * 1e-17; k++) {
+        term *= q / (double(k) * double(k));
+        sum += term;
+    }
+    return sum;
+}
+
+template <typename T>
+BasicWindowTable<T>::BasicWindowTable(WindowType type, unsigned size, double kaiserBeta) : _type(type), _size(size), _coefficients(size), _coherentGain(1.0) {
+    static const double hann[] = { 0.5, 0.5 };
+    static const double blackmanHarris[] = { 0.35875, 0.48829, 0.14128, 0.01168 };
+    static const double flatTop[] = { 0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368 };
+
+    // Computed in double and rounded once to T
+    const double pi = std::acos(-1.0);
+    double sum = 0.0;
+    for (unsigned n = 0; n < size; n++) {
+        const double phase = 2.0 * pi * n / size;
+        double w = 1.0;
+        switch (type) {
+        case WindowType::Rectangular:
+            break;
+        case WindowType::Hann:
+            w = cosineSum(hann, 2, phase);
+            break;
+        case WindowType::BlackmanHarris:
+            w = cosineSum(blackmanHarris, 4, phase);
+            break;
+        case WindowType::FlatTop:
+            w = cosineSum(flatTop, 5, phase);
+            break;
+        case WindowType::Kaiser: {
+            const double r = 2.0 * n / size - 1.0;
+            w = besselI0(kaiserBeta * std::sqrt(1.0 - r * r)) / besselI0(kaiserBeta);
+            break;
+        }
+        }
+        _coefficients[n] = T(w);
+        sum += w;
+    }
+
+    if (size > 0) {
+        _coherentGain = sum / size;
+    }
+}
+
+template <typename T>
+std::shared_ptr<const BasicWindowTable<T> > BasicWindowTable<T>::forSize(WindowType type, unsigned size, double kaiserBeta) {
+    // One registry per precision
+    static std::mutex mutex;
+    static std::map<std::tuple<WindowType, unsigned, double>, std::weak_ptr<const BasicWindowTable> > registry;
+
+    // beta only matters for the Kaiser window
+    const auto key = std::make_tuple(type, size, type == WindowType::Kaiser ? kaiserBeta : 0.0);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const BasicWindowTable> table = registry[key].lock();
+    if (!table) {
+        table = std::make_shared<const BasicWindowTable>(type, size, kaiserBeta);
+        registry[key] = table;
+    }
+
+    return table;
+}
+
+template class BasicWindowTable<float>;
+template class BasicWindowTable<double>;
@@ -0,0 +1,80 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+#ifndef WINDOWTABLE_H
+#define WINDOWTABLE_H
+
+#include <memory>
+#include "alignedallocator.h"
+
+// Tapers applied to a frame before its FFT, to keep the leakage of strong
+// components out of the neighbouring bins
+enum class WindowType {
+    // No window: the narrowest peaks, but -13 dB sidelobes
+    Rectangular,
+    // General purpose, -31 dB sidelobes
+    Hann,
+    // 4-term Blackman-Harris, -92 dB sidelobes for a wide dynamic range
+    BlackmanHarris,
+    // Flat top, the amplitude of a peak is read within 0.01 dB between bins
+    FlatTop,
+    // Kaiser, the beta parameter trades the main lobe width for the sidelobes
+    Kaiser
+};
+
+// Short stable name, for settings files
+const char *windowName(WindowType type);
+// Rectangular for unknown names
+WindowType windowTypeByName(const char *name);
+
+// Read-only coefficients of a window, periodic (the DFT-even form that
+// suits spectral analysis), with their peak at 1.
+// Tables are shared between every engine of the same size and precision,
+// use forSize() to get one.
+template <typename T>
+class BasicWindowTable final {
+private:
+    WindowType _type;
+    unsigned _size;
+    AlignedVector<T> _coefficients;
+    double _coherentGain;
+
+public:
+    BasicWindowTable(WindowType type, unsigned size, double kaiserBeta = 9.0);
+
+    inline WindowType type() const {
+        return _type;
+    }
+
+    inline unsigned size() const {
+        return _size;
+    }
+
+    inline const T *coefficients() const {
+        return _coefficients.data();
+    }
+
+    // Mean of the coefficients: the peak of a windowed sine is that much
+    // lower than without a window, divide the magnitudes by it to compensate
+    inline double coherentGain() const {
+        return _coherentGain;
+    }
+
+    static std::shared_ptr<const BasicWindowTable> forSize(WindowType type, unsigned size, double kaiserBeta = 9.0);
+};
+
+typedef BasicWindowTable<float> WindowTable;
+
+#endif // WINDOWTABLE_H
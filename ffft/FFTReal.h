@@ -56,6 +56,9 @@ public:
 	long				get_length () const;
 	void				do_fft (DataType f [], const DataType x []) const;
 	void				do_ifft (const DataType f [], DataType x []) const;
+	void				do_fft (DataType f [], const DataType x [], DataType buffer []) const;
+	void				do_ifft (const DataType f [], DataType x [], DataType buffer []) const;
+	void				do_fft (DataType f [], const DataType x [], const DataType win [], DataType buffer []) const;
 	void				rescale (DataType x []) const;
 	DataType *		use_buffer () const;
 
@@ -74,7 +77,9 @@ private:
    // Over this bit depth, we use direct calculation for sin/cos
    enum {	      TRIGO_BD_LIMIT	= 12  };
 
-	typedef	OscSinCos <DataType>	OscType;
+	// The oscillators run in double precision: in float their rounding
+	// errors pile up over the passes above TRIGO_BD_LIMIT (~80 dB SNR at 2^16)
+	typedef	OscSinCos <double>	OscType;
 
 	void				init_br_lut ();
 	void				init_trigo_lut ();
@@ -87,14 +92,14 @@ private:
 	ffft_FORCEINLINE long
 						get_trigo_level_index (int level) const;
 
-	inline void		compute_fft_general (DataType f [], const DataType x []) const;
-	inline void		compute_direct_pass_1_2 (DataType df [], const DataType x []) const;
+	inline void		compute_fft_general (DataType f [], const DataType x [], const DataType win [], DataType buffer []) const;
+	inline void		compute_direct_pass_1_2 (DataType df [], const DataType x [], const DataType win []) const;
 	inline void		compute_direct_pass_3 (DataType df [], const DataType sf []) const;
 	inline void		compute_direct_pass_n (DataType df [], const DataType sf [], int pass) const;
 	inline void		compute_direct_pass_n_lut (DataType df [], const DataType sf [], int pass) const;
 	inline void		compute_direct_pass_n_osc (DataType df [], const DataType sf [], int pass) const;
 
-	inline void		compute_ifft_general (const DataType f [], DataType x []) const;
+	inline void		compute_ifft_general (const DataType f [], DataType x [], DataType buffer []) const;
 	inline void		compute_inverse_pass_n (DataType df [], const DataType sf [], int pass) const;
 	inline void		compute_inverse_pass_n_osc (DataType df [], const DataType sf [], int pass) const;
 	inline void		compute_inverse_pass_n_lut (DataType df [], const DataType sf [], int pass) const;
@@ -107,10 +112,10 @@ private:
 						_br_lut;
 	DynArray <DataType>
 						_trigo_lut;
+	DynArray <OscType>
+						_trigo_osc;		// Step setup only, each pass runs a local copy
 	mutable DynArray <DataType>
-						_buffer;
-   mutable DynArray <OscType>
-						_trigo_osc;
+						_buffer;			// Scratch of the 2-argument do_fft() / do_ifft()
 
 
 
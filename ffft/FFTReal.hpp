@@ -92,8 +92,8 @@ FFTReal <DT>::FFTReal (long length)
 ,	_nbr_bits (FFTReal_get_next_pow2 (length))
 ,	_br_lut ()
 ,	_trigo_lut ()
-,	_buffer (length)
 ,	_trigo_osc ()
+,	_buffer (length)
 {
 	assert (FFTReal_is_pow2 (length));
 	assert (_nbr_bits <= MAX_BIT_DEPTH);
@@ -135,27 +135,92 @@ Output parameters:
 		f [0...length(x)/2] = real values,
 		f [length(x)/2+1...length(x)-1] = negative imaginary values of
 		coefficents 1...length(x)/2-1.
+	Uses the internal buffer as scratch: an object must not run two of these
+	calls at the same time. Use the buffer overload to share it between
+	threads.
 Throws: Nothing
 ==============================================================================
 */
 
 template <class DT>
 void	FFTReal <DT>::do_fft (DataType f [], const DataType x []) const
+{
+	do_fft (f, x, use_buffer ());
+}
+
+
+
+/*
+==============================================================================
+Name: do_fft
+Description:
+	Same as the 2-argument version, but works in a caller-supplied scratch
+	array instead of the internal buffer. The object is only read, so several
+	threads can share it as long as each one passes its own buffer.
+Input parameters:
+	- x: pointer on the source array (time).
+Output parameters:
+	- f: pointer on the destination array (frequencies), same layout as above.
+	- buffer: scratch array of get_length() values, content is erased.
+Throws: Nothing
+==============================================================================
+*/
+
+template <class DT>
+void	FFTReal <DT>::do_fft (DataType f [], const DataType x [], DataType buffer []) const
+{
+	do_fft (f, x, 0, buffer);
+}
+
+
+
+/*
+==============================================================================
+Name: do_fft
+Description:
+	Same as the buffer version, with x multiplied by an analysis window on
+	the fly. The product is folded into the bit-reversed load of the first
+	pass, so the windowed signal is never written out.
+Input parameters:
+	- x: pointer on the source array (time).
+	- win: pointer on the window coefficients, get_length() values. 0 means
+		no window.
+Output parameters:
+	- f: pointer on the destination array (frequencies), same layout as above.
+	- buffer: scratch array of get_length() values, content is erased.
+Throws: Nothing
+==============================================================================
+*/
+
+template <class DT>
+void	FFTReal <DT>::do_fft (DataType f [], const DataType x [], const DataType win [], DataType buffer []) const
 {
 	assert (f != 0);
-	assert (f != use_buffer ());
+	assert (f != buffer);
 	assert (x != 0);
-	assert (x != use_buffer ());
+	assert (x != buffer);
 	assert (x != f);
+	assert (buffer != 0);
 
 	// General case
 	if (_nbr_bits > 2)
 	{
-		compute_fft_general (f, x);
+		compute_fft_general (f, x, win, buffer);
+		return;
+	}
+
+	// The small cases have no first pass to fold the window into
+	if (win != 0)
+	{
+		for (long i = 0; i < _length; ++ i)
+		{
+			buffer [i] = x [i] * win [i];
+		}
+		x = buffer;
 	}
 
 	// 4-point FFT
-	else if (_nbr_bits == 2)
+	if (_nbr_bits == 2)
 	{
 		f [1] = x [0] - x [2];
 		f [3] = x [1] - x [3];
@@ -196,23 +261,48 @@ Input parameters:
 		coefficents 1...length(x)/2-1.
 Output parameters:
 	- x: pointer on the destination array (time).
+	Uses the internal buffer as scratch, same restriction as do_fft().
 Throws: Nothing
 ==============================================================================
 */
 
 template <class DT>
 void	FFTReal <DT>::do_ifft (const DataType f [], DataType x []) const
+{
+	do_ifft (f, x, use_buffer ());
+}
+
+
+
+/*
+==============================================================================
+Name: do_ifft
+Description:
+	Same as the 2-argument version, but works in a caller-supplied scratch
+	array instead of the internal buffer (see do_fft() above).
+Input parameters:
+	- f: pointer on the source array (frequencies).
+Output parameters:
+	- x: pointer on the destination array (time).
+	- buffer: scratch array of get_length() values, content is erased.
+Throws: Nothing
+==============================================================================
+*/
+
+template <class DT>
+void	FFTReal <DT>::do_ifft (const DataType f [], DataType x [], DataType buffer []) const
 {
 	assert (f != 0);
-	assert (f != use_buffer ());
+	assert (f != buffer);
 	assert (x != 0);
-	assert (x != use_buffer ());
+	assert (x != buffer);
 	assert (x != f);
+	assert (buffer != 0);
 
 	// General case
 	if (_nbr_bits > 2)
 	{
-		compute_ifft_general (f, x);
+		compute_ifft_general (f, x, buffer);
 	}
 
 	// 4-point IFFT
@@ -423,12 +513,12 @@ long	FFTReal <DT>::get_trigo_level_index (int level) const
 
 // Transform in several passes
 template <class DT>
-void	FFTReal <DT>::compute_fft_general (DataType f [], const DataType x []) const
+void	FFTReal <DT>::compute_fft_general (DataType f [], const DataType x [], const DataType win [], DataType buffer []) const
 {
 	assert (f != 0);
-	assert (f != use_buffer ());
+	assert (f != buffer);
 	assert (x != 0);
-	assert (x != use_buffer ());
+	assert (x != buffer);
 	assert (x != f);
 
 	DataType *		sf;
@@ -436,16 +526,16 @@ void	FFTReal <DT>::compute_fft_general (DataType f [], const DataType x []) cons
 
 	if ((_nbr_bits & 1) != 0)
 	{
-		df = use_buffer ();
+		df = buffer;
 		sf = f;
 	}
 	else
 	{
 		df = f;
-		sf = use_buffer ();
+		sf = buffer;
 	}
 
-	compute_direct_pass_1_2 (df, x);
+	compute_direct_pass_1_2 (df, x, win);
 	compute_direct_pass_3 (sf, df);
 
 	for (int pass = 3; pass < _nbr_bits; ++ pass)
@@ -461,7 +551,7 @@ void	FFTReal <DT>::compute_fft_general (DataType f [], const DataType x []) cons
 
 
 template <class DT>
-void	FFTReal <DT>::compute_direct_pass_1_2 (DataType df [], const DataType x []) const
+void	FFTReal <DT>::compute_direct_pass_1_2 (DataType df [], const DataType x [], const DataType win []) const
 {
 	assert (df != 0);
 	assert (x != 0);
@@ -469,6 +559,38 @@ void	FFTReal <DT>::compute_direct_pass_1_2 (DataType df [], const DataType x [])
 
 	const long * const	bit_rev_lut_ptr = get_br_ptr ();
 	long				coef_index = 0;
+
+	if (win != 0)
+	{
+		do
+		{
+			const long		rev_index_0 = bit_rev_lut_ptr [coef_index];
+			const long		rev_index_1 = bit_rev_lut_ptr [coef_index + 1];
+			const long		rev_index_2 = bit_rev_lut_ptr [coef_index + 2];
+			const long		rev_index_3 = bit_rev_lut_ptr [coef_index + 3];
+
+			const DataType	x_0 = x [rev_index_0] * win [rev_index_0];
+			const DataType	x_1 = x [rev_index_1] * win [rev_index_1];
+			const DataType	x_2 = x [rev_index_2] * win [rev_index_2];
+			const DataType	x_3 = x [rev_index_3] * win [rev_index_3];
+
+			DataType	* const	df2 = df + coef_index;
+			df2 [1] = x_0 - x_1;
+			df2 [3] = x_2 - x_3;
+
+			const DataType	sf_0 = x_0 + x_1;
+			const DataType	sf_2 = x_2 + x_3;
+
+			df2 [0] = sf_0 + sf_2;
+			df2 [2] = sf_0 - sf_2;
+
+			coef_index += 4;
+		}
+		while (coef_index < _length);
+
+		return;
+	}
+
 	do
 	{
 		const long		rev_index_0 = bit_rev_lut_ptr [coef_index];
@@ -612,7 +734,7 @@ void	FFTReal <DT>::compute_direct_pass_n_osc (DataType df [], const DataType sf
 	const long		h_nbr_coef = nbr_coef >> 1;
 	const long		d_nbr_coef = nbr_coef << 1;
 	long				coef_index = 0;
-	OscType &		osc = _trigo_osc [pass - (TRIGO_BD_LIMIT + 1)];
+	OscType			osc (_trigo_osc [pass - (TRIGO_BD_LIMIT + 1)]);
 	do
 	{
 		const DataType	* const	sf1r = sf + coef_index;
@@ -656,12 +778,12 @@ void	FFTReal <DT>::compute_direct_pass_n_osc (DataType df [], const DataType sf
 
 // Transform in several pass
 template <class DT>
-void	FFTReal <DT>::compute_ifft_general (const DataType f [], DataType x []) const
+void	FFTReal <DT>::compute_ifft_general (const DataType f [], DataType x [], DataType buffer []) const
 {
 	assert (f != 0);
-	assert (f != use_buffer ());
+	assert (f != buffer);
 	assert (x != 0);
-	assert (x != use_buffer ());
+	assert (x != buffer);
 	assert (x != f);
 
 	DataType *		sf = const_cast <DataType *> (f);
@@ -670,13 +792,13 @@ void	FFTReal <DT>::compute_ifft_general (const DataType f [], DataType x []) con
 
 	if (_nbr_bits & 1)
 	{
-		df = use_buffer ();
+		df = buffer;
 		df_temp = x;
 	}
 	else
 	{
 		df = x;
-		df_temp = use_buffer ();
+		df_temp = buffer;
 	}
 
 	for (int pass = _nbr_bits - 1; pass >= 3; -- pass)
@@ -787,7 +909,7 @@ void	FFTReal <DT>::compute_inverse_pass_n_osc (DataType df [], const DataType sf
 	const long		h_nbr_coef = nbr_coef >> 1;
 	const long		d_nbr_coef = nbr_coef << 1;
 	long				coef_index = 0;
-	OscType &		osc = _trigo_osc [pass - (TRIGO_BD_LIMIT + 1)];
+	OscType			osc (_trigo_osc [pass - (TRIGO_BD_LIMIT + 1)]);
 	do
 	{
 		const DataType	* const	sfr = sf + coef_index;
@@ -50,7 +50,7 @@ class FFTRealFixLen
 public:
 
    typedef	FFTRealFixLenParam::DataType   DataType;
-	typedef	OscSinCos <DataType>	OscType;
+	typedef	OscSinCos <double>	OscType;
 
 	enum {			FFT_LEN_L2	= LL2	};
 	enum {			FFT_LEN		= 1 << FFT_LEN_L2	};
@@ -59,6 +59,7 @@ public:
 
 	inline long		get_length () const;
 	void				do_fft (DataType f [], const DataType x []);
+	void				do_fft (DataType f [], const DataType x [], const DataType win []);
 	void				do_ifft (const DataType f [], DataType x []);
 	void				rescale (DataType x []) const;
 
@@ -73,6 +73,14 @@ long	FFTRealFixLen <LL2>::get_length () const
 // General case
 template <int LL2>
 void	FFTRealFixLen <LL2>::do_fft (DataType f [], const DataType x [])
+{
+	do_fft (f, x, 0);
+}
+
+// x multiplied by the window win on the fly (0 for none), folded into the
+// bit-reversed load of the first pass
+template <int LL2>
+void	FFTRealFixLen <LL2>::do_fft (DataType f [], const DataType x [], const DataType win [])
 {
 	assert (f != 0);
 	assert (x != 0);
@@ -88,6 +96,7 @@ void	FFTRealFixLen <LL2>::do_fft (DataType f [], const DataType x [])
 		f,
 		&_buffer [0],
 		x,
+		win,
 		cos_ptr,
 		TRIGO_TABLE_ARR_SIZE,
 		br_ptr,
@@ -135,6 +144,62 @@ inline void	FFTRealFixLen <0>::do_fft (DataType f [], const DataType x [])
 	f [0] = x [0];
 }
 
+// Up to 4 points there is no first pass to fold the window into
+
+template <>
+inline void	FFTRealFixLen <2>::do_fft (DataType f [], const DataType x [], const DataType win [])
+{
+	assert (f != 0);
+	assert (x != 0);
+
+	if (win != 0)
+	{
+		for (long i = 0; i < FFT_LEN; ++ i)
+		{
+			_buffer [i] = x [i] * win [i];
+		}
+		x = &_buffer [0];
+	}
+
+	do_fft (f, x);
+}
+
+template <>
+inline void	FFTRealFixLen <1>::do_fft (DataType f [], const DataType x [], const DataType win [])
+{
+	assert (f != 0);
+	assert (x != 0);
+
+	if (win != 0)
+	{
+		for (long i = 0; i < FFT_LEN; ++ i)
+		{
+			_buffer [i] = x [i] * win [i];
+		}
+		x = &_buffer [0];
+	}
+
+	do_fft (f, x);
+}
+
+template <>
+inline void	FFTRealFixLen <0>::do_fft (DataType f [], const DataType x [], const DataType win [])
+{
+	assert (f != 0);
+	assert (x != 0);
+
+	if (win != 0)
+	{
+		for (long i = 0; i < FFT_LEN; ++ i)
+		{
+			_buffer [i] = x [i] * win [i];
+		}
+		x = &_buffer [0];
+	}
+
+	do_fft (f, x);
+}
+
 
 
 // General case
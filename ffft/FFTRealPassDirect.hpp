@@ -41,12 +41,45 @@ namespace ffft
 
 
 template <>
-inline void	FFTRealPassDirect <1>::process (long len, DataType dest_ptr [], DataType src_ptr [], const DataType x_ptr [], const DataType cos_ptr [], long cos_len, const long br_ptr [], OscType osc_list [])
+inline void	FFTRealPassDirect <1>::process (long len, DataType dest_ptr [], DataType src_ptr [], const DataType x_ptr [], const DataType win_ptr [], const DataType cos_ptr [], long cos_len, const long br_ptr [], OscType osc_list [])
 {
 	// First and second pass at once
 	const long		qlen = len >> 2;
 
 	long				coef_index = 0;
+
+	// Same with the analysis window applied on the bit-reversed load
+	if (win_ptr != 0)
+	{
+		do
+		{
+			const long		ri_0 = br_ptr [coef_index >> 2];
+			const long		ri_1 = ri_0 + 2 * qlen;
+			const long		ri_2 = ri_0 + 1 * qlen;
+			const long		ri_3 = ri_0 + 3 * qlen;
+
+			const DataType	x_0 = x_ptr [ri_0] * win_ptr [ri_0];
+			const DataType	x_1 = x_ptr [ri_1] * win_ptr [ri_1];
+			const DataType	x_2 = x_ptr [ri_2] * win_ptr [ri_2];
+			const DataType	x_3 = x_ptr [ri_3] * win_ptr [ri_3];
+
+			DataType	* const	df2 = dest_ptr + coef_index;
+			df2 [1] = x_0 - x_1;
+			df2 [3] = x_2 - x_3;
+
+			const DataType	sf_0 = x_0 + x_1;
+			const DataType	sf_2 = x_2 + x_3;
+
+			df2 [0] = sf_0 + sf_2;
+			df2 [2] = sf_0 - sf_2;
+
+			coef_index += 4;
+		}
+		while (coef_index < len);
+
+		return;
+	}
+
 	do
 	{
 		// To do: unroll the loop (2x).
@@ -71,7 +104,7 @@ inline void	FFTRealPassDirect <1>::process (long len, DataType dest_ptr [], Data
 }
 
 template <>
-inline void	FFTRealPassDirect <2>::process (long len, DataType dest_ptr [], DataType src_ptr [], const DataType x_ptr [], const DataType cos_ptr [], long cos_len, const long br_ptr [], OscType osc_list [])
+inline void	FFTRealPassDirect <2>::process (long len, DataType dest_ptr [], DataType src_ptr [], const DataType x_ptr [], const DataType win_ptr [], const DataType cos_ptr [], long cos_len, const long br_ptr [], OscType osc_list [])
 {
 	// Executes "previous" passes first. Inverts source and destination buffers
 	FFTRealPassDirect <1>::process (
@@ -79,6 +112,7 @@ inline void	FFTRealPassDirect <2>::process (long len, DataType dest_ptr [], Data
 		src_ptr,
 		dest_ptr,
 		x_ptr,
+		win_ptr,
 		cos_ptr,
 		cos_len,
 		br_ptr,
@@ -112,7 +146,7 @@ inline void	FFTRealPassDirect <2>::process (long len, DataType dest_ptr [], Data
 }
 
 template <int PASS>
-void	FFTRealPassDirect <PASS>::process (long len, DataType dest_ptr [], DataType src_ptr [], const DataType x_ptr [], const DataType cos_ptr [], long cos_len, const long br_ptr [], OscType osc_list [])
+void	FFTRealPassDirect <PASS>::process (long len, DataType dest_ptr [], DataType src_ptr [], const DataType x_ptr [], const DataType win_ptr [], const DataType cos_ptr [], long cos_len, const long br_ptr [], OscType osc_list [])
 {
 	// Executes "previous" passes first. Inverts source and destination buffers
 	FFTRealPassDirect <PASS - 1>::process (
@@ -120,6 +154,7 @@ void	FFTRealPassDirect <PASS>::process (long len, DataType dest_ptr [], DataType
 		src_ptr,
 		dest_ptr,
 		x_ptr,
+		win_ptr,
 		cos_ptr,
 		cos_len,
 		br_ptr,
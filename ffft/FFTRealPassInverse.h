@@ -48,7 +48,7 @@ class FFTRealPassInverse
 public:
 
    typedef	FFTRealFixLenParam::DataType	DataType;
-	typedef	OscSinCos <DataType>	OscType;
+	typedef	OscSinCos <double>	OscType;
 
 	ffft_FORCEINLINE static void
 						process (long len, DataType dest_ptr [], DataType src_ptr [], const DataType f_ptr [], const DataType cos_ptr [], long cos_len, const long br_ptr [], OscType osc_list []);
@@ -47,7 +47,7 @@ class FFTRealUseTrigo
 public:
 
    typedef	FFTRealFixLenParam::DataType	DataType;
-	typedef	OscSinCos <DataType>	OscType;
+	typedef	OscSinCos <double>	OscType;
 
 	ffft_FORCEINLINE static void
 						prepare (OscType &osc);
@@ -83,8 +83,6 @@ private:
 
 private:
 
-						OscSinCos (const OscSinCos &other);
-	OscSinCos &		operator = (const OscSinCos &other);
 	bool				operator == (const OscSinCos &other);
 	bool				operator != (const OscSinCos &other);
 
@@ -0,0 +1,46 @@
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// This file is part of the frequency-analyzer application.
+// It is licensed to you under the terms of the MIT license.
+// http://opensource.org/licenses/MIT
+//
+// Copyright (c) 2014 Timur Kristóf
+
+// Accuracy tests of the DFT engines: runs the whole DftConformance suite,
+// prints the checks that fail and exits with 1 if there are any.
+// `make check` builds and runs it. FA_SIMD_LEVEL selects the SIMD kernels
+// that are tested.
+//
+// Usage: dft-tests [max log2 of the sizes, 14 by default]
+
+#include <cstdlib>
+#include <iostream>
+
+#include "dft/conformance.h"
+#include "dft/cpufeatures.h"
+#include "dft/dftfactory.h"
+
+int main(int argc, char *argv[]) {
+    unsigned maxLog2 = (argc > 1) ? unsigned(std::atoi(argv[1])) : 14;
+
+    unsigned checks = 0, failures = 0;
+    bool ok = DftConformance::run(DftFactory::engines(), DftConformance::testSizes(1, maxLog2), true, [&](const DftConformance::Case &accuracy) {
+        checks++;
+        if (!accuracy.passed) {
+            failures++;
+            std::cout << "FAIL " << accuracy.engine << ", size " << accuracy.size << ", " << DftConformance::name(accuracy.signal)
+                      << " signal, " << accuracy.path << ": " << accuracy.result.snrDb << " dB SNR, expected at least "
+                      << accuracy.minimumSnrDb << std::endl;
+        }
+    });
+
+    std::cout << checks << " checks at SIMD level " << simdLevelName(simdLevel()) << ", " << failures << " failed" << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,11 @@
+TEMPLATE = app
+TARGET = dft-tests
+
+QT = core
+# testcase adds a check target that runs the tests: qmake && make check
+CONFIG += console c++17 testcase
+CONFIG -= app_bundle
+
+SOURCES += main.cpp
+
+include(../dft/dft.pri)
@@ -4,13 +4,16 @@
 
 #include "waterfallitem.h"
 #include "audiosampler.h"
-#include "dft/radix2fft.h"
+#include "dft/dftplanner.h"
+#include "dft/fixedpointfft.h"
+#include "dft/sampleconversion.h"
 
 #include <QDebug>
 #include <QCoreApplication>
 #include <QPainter>
 #include <QLinearGradient>
 #include <QStandardPaths>
+#include <QtConcurrent>
 #include <QDir>
 #include <QFile>
 #include <QJsonDocument>
@@ -21,7 +24,12 @@
 WaterfallItem::WaterfallItem(QQuickItem *parent)
     : QQuickPaintedItem(parent),
     _sampler(this),
-    _dft(nullptr),
+    _planner(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/wisdom.json"),
+    _sliding(nullptr),
+    _analysisMode(FftAnalysis),
+    _windowFunction(HannWindow),
+    _windowGain(1.0f),
+    _goertzel(float(_sampler.samplingFrequency())),
     _samplesUpdated(false),
     _sampleNumber(0),
     _sensitivity(0.05f),
@@ -29,6 +37,12 @@ WaterfallItem::WaterfallItem(QQuickItem *parent)
 
 {
     connect(&_sampler, &AudioSampler::samplesCollected, this, &WaterfallItem::samplesCollected);
+    connect(&_sampler, &AudioSampler::samplesToWaitChanged, this, &WaterfallItem::samplesToWaitChanged);
+    connect(&_sampler, &AudioSampler::hopCollected, this, &WaterfallItem::hopCollected);
+    connect(&_sampler, &AudioSampler::hopSizeChanged, this, &WaterfallItem::samplerHopSizeChanged);
+    connect(&_sampler, &AudioSampler::fixedPointSamplesCollected, this, &WaterfallItem::fixedPointSamplesCollected);
+    connect(&_sampler, &AudioSampler::fixedPointChanged, this, &WaterfallItem::samplerFixedPointChanged);
+    connect(&_planning, &QFutureWatcher<void>::finished, this, &WaterfallItem::planningFinished);
     connect(this, &QQuickItem::widthChanged, this, &WaterfallItem::sizeChanged);
     connect(this, &QQuickItem::heightChanged, this, &WaterfallItem::sizeChanged);
 
@@ -50,7 +64,7 @@ _previousLevels.resize(_barCount, 0.0f);
     _sampleNumber = _sampler.samplesToWait();
     _image = QImage(int(width()), int(height()), QImage::Format_ARGB32_Premultiplied);
     _image.fill(Qt::transparent);
-    _dft = new Radix2Fft(_sampleNumber);
+    createEngine();
 
     // === Prépare le gradient couleur (spectre) ===
     _gradientImg = QImage(500, 1, QImage::Format_ARGB32);
@@ -71,6 +85,95 @@ _previousLevels.resize(_barCount, 0.0f);
     update();
 }
 
+WaterfallItem::~WaterfallItem() {
+    _planning.waitForFinished(); // la mesure utilise _planner
+    delete _sliding;
+}
+
+// === Création du moteur FFT ===
+// Le moteur est choisi par le planificateur : le plus rapide pour la taille,
+// mesuré au premier usage puis relu depuis wisdom.json. La mesure prend plusieurs
+// dixièmes de seconde : elle tourne dans le pool de threads, et le moteur par défaut
+// de DftFactory sert en attendant (remplacé dans planningFinished()).
+// En mode virgule fixe, c'est le FFT Q15 (puissances de 2 seulement) : pour les
+// autres tailles, le mode virgule fixe est désactivé, sinon l'échantillonneur
+// continuerait à n'envoyer que des trames int16 qu'aucun moteur ne lirait.
+void WaterfallItem::createEngine() {
+    Dft *dft = nullptr;
+    if (_sampler.fixedPoint()) {
+        dft = DftFactory::create(_sampleNumber, DftFactory::Engine::FixedPoint);
+        if (!dft) {
+            qWarning() << "⚠️ Pas de FFT virgule fixe pour fftSize =" << _sampleNumber << ", retour au mode flottant";
+            _sampler.setFixedPoint(false); // rappelle createEngine() via fixedPointChanged
+            return;
+        }
+    }
+    if (!dft && _planner.planned(_sampleNumber)) {
+        dft = _planner.create(_sampleNumber);
+    }
+    else if (!dft) {
+        dft = DftFactory::create(_sampleNumber);
+        // une seule mesure à la fois : planningFinished() relance pour la taille courante
+        if (!_planning.isRunning())
+            _planning.setFuture(QtConcurrent::run([this, size = _sampleNumber] { _planner.plan(size); }));
+    }
+    _dft = DftHandle(dft);
+    _bins.resize(_dft.binCount());
+    _magnitudes.resize(_sampleNumber / 2 + 1);
+    applyWindow();
+}
+
+// === Fenêtre d'analyse ===
+// La table est calculée une fois par taille et partagée (WindowTable::forSize),
+// et le moteur multiplie par la fenêtre pendant son chargement en ordre bit-inversé :
+// le fenêtrage ne coûte pas de passe mémoire en plus.
+void WaterfallItem::applyWindow() {
+    if (_windowFunction == RectangularWindow) {
+        _dft.get()->setWindow(nullptr);
+        _windowGain = 1.0f;
+        return;
+    }
+
+    std::shared_ptr<const WindowTable> window = WindowTable::forSize(WindowType(_windowFunction), _sampleNumber);
+    _dft.get()->setWindow(window);
+    _windowGain = float(1.0 / window->coherentGain());
+}
+
+// === Taille du FFT modifiée ===
+void WaterfallItem::samplesToWaitChanged(quint32 value) {
+    _sampleNumber = value;
+    createEngine();
+    if (_sliding) {
+        delete _sliding;
+        _sliding = new SlidingDft(_sampleNumber);
+    }
+    configureGoertzel(); // les longueurs de bloc par défaut suivent fftSize
+    emit fftSizeChanged();
+}
+
+// === Mode glissant activé / désactivé ===
+void WaterfallItem::samplerHopSizeChanged(quint32 value) {
+    delete _sliding;
+    _sliding = value ? new SlidingDft(_sampleNumber) : nullptr;
+    emit hopSizeChanged();
+}
+
+// === Mode virgule fixe activé / désactivé ===
+void WaterfallItem::samplerFixedPointChanged(bool value) {
+    Q_UNUSED(value)
+    createEngine();
+    emit fixedPointChanged();
+}
+
+// === Mesure du planificateur terminée ===
+// La taille a pu changer pendant la mesure : createEngine() prend alors le
+// moteur mesuré, ou relance une mesure pour la nouvelle taille.
+void WaterfallItem::planningFinished() {
+    if (_sampler.fixedPoint())
+        return;
+    createEngine();
+}
+
 // === Taille modifiée ===
 void WaterfallItem::sizeChanged() {
     _image = QImage(int(width()), int(height()), QImage::Format_ARGB32_Premultiplied);
@@ -117,10 +220,123 @@ void WaterfallItem::setSensitivity(float value) {
         emit sensitivityChanged();
     }
 }
-void WaterfallItem::samplesCollected(std::vector<float> *samples)
+void WaterfallItem::samplesCollected(const std::vector<float> &samples)
+{
+    if (_analysisMode == GoertzelAnalysis) {
+        goertzelCollected(samples);
+        return;
+    }
+
+    if (samples.size() < _dft.sampleCount())
+        return;
+
+    // calcul dans le tampon du membre : aucune allocation par trame,
+    // et appel direct du moteur choisi (pas de vtable)
+    _dft.visit([&](auto &dft) { dft.computeSplit(samples.data(), _bins.real(), _bins.imag()); });
+    renderSpectrum();
+}
+
+// === Nouvelle trame int16 en mode virgule fixe ===
+// Les échantillons vont tels quels dans le FFT Q15, sans passer par des float.
+// Le banc de Goertzel, lui, n'existe qu'en float : la trame y est convertie.
+void WaterfallItem::fixedPointSamplesCollected(const std::vector<qint16> &samples)
+{
+    if (_analysisMode == GoertzelAnalysis) {
+        _goertzelSamples.resize(samples.size());
+        convertSamples(samples.data(), _goertzelSamples.data(), unsigned(samples.size()));
+        goertzelCollected(_goertzelSamples);
+        return;
+    }
+
+    FixedPointFft *fft = _dft.getIf<FixedPointFft>();
+    if (!fft || samples.size() < fft->sampleCount())
+        return;
+
+    fft->computeSplit(samples.data(), _bins.real(), _bins.imag());
+    renderSpectrum();
+}
+
+// === Nouveau saut en mode glissant ===
+// La fenêtre glisse de hopSize échantillons, sans recalculer un FFT complet à chaque fois.
+void WaterfallItem::hopCollected(const std::vector<float> &samples)
 {
-    std::vector<std::complex<float>> result = _dft->compute(*samples);
-    delete samples;
+    if (_analysisMode == GoertzelAnalysis) {
+        goertzelCollected(samples);
+        return;
+    }
+
+    if (!_sliding)
+        return;
+
+    _sliding->push(samples.data(), unsigned(samples.size()));
+    _sliding->spectrum(_bins.real(), _bins.imag());
+    renderSpectrum();
+}
+
+// === Mode Goertzel ===
+// Seules les fréquences surveillées sont calculées. Elles sont placées dans un spectre
+// synthétique (_bins à zéro ailleurs), à l'échelle d'un FFT de fftSize échantillons,
+// pour que la fréquence dominante et les barres fonctionnent sans changement.
+void WaterfallItem::goertzelCollected(const std::vector<float> &samples)
+{
+    _goertzel.push(samples.data(), unsigned(samples.size()));
+
+    const unsigned N = _sampleNumber;
+    const float fs = float(_sampler.samplingFrequency());
+    float *real = _bins.real();
+    std::fill(real, real + _bins.size(), 0.0f);
+    std::fill(_bins.imag(), _bins.imag() + _bins.size(), 0.0f);
+    for (unsigned i = 0; i < _goertzel.size(); ++i) {
+        unsigned idx = unsigned(std::lround(_goertzel.frequency(i) * N / fs));
+        if (idx > N / 2 || idx >= _bins.size())
+            continue;
+        float mag = _goertzel.magnitude(i) * float(N) / float(_goertzel.blockLength(i));
+        if (mag > real[idx])
+            real[idx] = mag;
+    }
+
+    renderSpectrum(true);
+}
+
+void WaterfallItem::configureGoertzel()
+{
+    _goertzel.clear();
+    const float nyquist = _sampler.samplingFrequency() / 2.0f;
+    for (const QVariant &entry : _goertzelFrequencies) {
+        QVariantMap map = entry.toMap();
+        float frequency = map.isEmpty() ? entry.toFloat() : map.value("frequency").toFloat();
+        unsigned blockLength = map.value("blockLength", 0).toUInt();
+        if (frequency <= 0.0f || frequency >= nyquist) {
+            qWarning() << "⚠️ Fréquence Goertzel ignorée :" << entry;
+            continue;
+        }
+        _goertzel.add(frequency, blockLength ? blockLength : _goertzel.wholePeriods(frequency, _sampleNumber));
+    }
+}
+
+// === Dessin des barres et du spectre QML à partir de _bins ===
+// sparse : seules quelques cases sont remplies (Goertzel), chaque barre prend
+// alors le maximum des cases qu'elle couvre au lieu d'une seule case.
+void WaterfallItem::renderSpectrum(bool sparse)
+{
+    // module des N/2 + 1 premiers bins en une seule passe vectorisée, sans mélange de voies
+    // grâce au format séparé (et la case la plus forte pour la fréquence dominante) :
+    // toute la suite lit ce tableau, sans std::abs par case
+    const unsigned N = _sampleNumber;
+    unsigned maxIndex = magnitudeSpectrum(_bins.real(), _bins.imag(), _magnitudes.data(), N / 2);
+    _magnitudes[N / 2] = std::abs(_bins[N / 2]);
+    const AlignedVector<float> &result = _magnitudes;
+    // la fenêtre ne s'applique qu'aux trames passées au FFT
+    const float gain = (sparse || _sliding) ? 1.0f : _windowGain;
+
+    auto binMagnitude = [&](unsigned idx, unsigned first, unsigned last) {
+        float mag = result[idx];
+        if (sparse) {
+            for (unsigned b = first; b < last && b < result.size(); ++b)
+                mag = std::max(mag, result[b]);
+        }
+        return mag * gain;
+    };
 
     const int W = int(width());
     const int H = int(height());
@@ -130,10 +346,12 @@ void WaterfallItem::samplesCollected(std::vector<float> *samples)
     if ((int)_previousLevels.size() < _barCount)
         _previousLevels.resize(_barCount, 0.0f);
 
-    QImage img(W, H, QImage::Format_ARGB32_Premultiplied);
-    img.fill(Qt::transparent);
+    // on redessine directement dans _image (réutilisée d'une trame à l'autre)
+    if (_image.width() != W || _image.height() != H)
+        _image = QImage(W, H, QImage::Format_ARGB32_Premultiplied);
+    _image.fill(Qt::transparent);
 
-    QPainter p(&img);
+    QPainter p(&_image);
     p.setRenderHint(QPainter::Antialiasing, true);
 
     // --- paramètres globaux (une seule fois) ---
@@ -152,12 +370,8 @@ void WaterfallItem::samplesCollected(std::vector<float> *samples)
     const float release = baseRelease * (0.3f + _smoothness * 4.0f * 1.5f);
 
     // fréquence dominante (facultatif pour l’affichage)
-    float maxVal = 0.0f; unsigned maxIndex = 0u;
-    for (unsigned i = 0; i < result.size() / 2; ++i) {
-        float mag = std::abs(result[i]);
-        if (mag > maxVal) { maxVal = mag; maxIndex = i; }
-    }
-    _dominantFrequency = (_sampler.samplingFrequency() * float(maxIndex)) / float(result.size());
+    // (le FFT réel ne renvoie que les N/2 + 1 premiers bins)
+    _dominantFrequency = (_sampler.samplingFrequency() * float(maxIndex)) / float(N);
     emit dominantFrequencyChanged();
 
     for (int i = 0; i < _barCount; ++i) {
@@ -173,11 +387,12 @@ void WaterfallItem::samplesCollected(std::vector<float> *samples)
 
         unsigned idx = static_cast<unsigned>(std::pow(float(i) / (_barCount - 1), 3.0f) * (_sampleNumber / 2 - 1));
         if (idx >= result.size()) continue;
+        unsigned nextIdx = static_cast<unsigned>(std::pow(float(i + 1) / (_barCount - 1), 3.0f) * (_sampleNumber / 2 - 1));
 
         // Correction fréquentielle de base
         float freqBoost = 0.5f + 1.2f * std::pow((float(i) / _barCount), 0.8f);
         float freqNorm  = 1.0f / std::sqrt(1.0f + 8.0f * (float(i) / _barCount));
-        float magnitude = std::abs(result[idx]) * freqBoost * freqNorm;
+        float magnitude = binMagnitude(idx, idx, nextIdx) * freqBoost * freqNorm;
 
         // Ensuite boost haute fréquence
         float freqRatio = float(i) / _barCount;
@@ -190,7 +405,7 @@ void WaterfallItem::samplesCollected(std::vector<float> *samples)
             magnitude = 0.0f;
 
         // Log + normalisation
-        float logAmp  = std::log10(1.0f + magnitude / (adaptiveRange * 0.6f));
+        float logAmp  = fastLog10(1.0f + magnitude / (adaptiveRange * 0.6f));
         float target  = std::clamp(std::pow(logAmp, 0.75f), 0.0f, 1.0f);
 
 
@@ -285,14 +500,19 @@ void WaterfallItem::samplesCollected(std::vector<float> *samples)
     }
 
     p.end();
-    _image = img;
 
     // spectre pour le QML (même normalisation que ci-dessus)
     _spectrum.clear();
     for (int i = 0; i < 128; ++i) {
-        unsigned idx = i * result.size() / 128;
-        float mag = std::abs(result[idx]);
-        float norm = std::clamp(std::log10(1.0f + mag / adaptiveRange), 0.0f, 1.0f);
+        unsigned idx = i * N / 128;
+        unsigned first = idx, last = (i + 1) * N / 128;
+        if (idx > N / 2) { // symétrie du spectre d'un signal réel
+            idx = N - idx;
+            first = N - last + 1;
+            last = idx + 1;
+        }
+        float mag = binMagnitude(idx, first, last);
+        float norm = std::clamp(fastLog10(1.0f + mag / adaptiveRange), 0.0f, 1.0f);
         _spectrum.append(norm);
     }
     emit spectrumChanged();
@@ -313,6 +533,53 @@ void WaterfallItem::setBarrenumber(float value) {
     _previousLevels.resize(_barCount, 0.0f);
     emit barrenumberChanged();
 }
+
+void WaterfallItem::setFftSize(int value) {
+    _sampler.setSamplesToWait(quint32(std::max(1, value)));
+}
+
+void WaterfallItem::setHopSize(int value) {
+    _sampler.setHopSize(quint32(std::max(0, value)));
+}
+
+void WaterfallItem::setFixedPoint(bool value) {
+    _sampler.setFixedPoint(value);
+}
+
+void WaterfallItem::setAnalysisMode(AnalysisMode value) {
+    if (_analysisMode == value)
+        return;
+
+    _analysisMode = value;
+    _goertzel.reset();
+    emit analysisModeChanged();
+}
+
+void WaterfallItem::setWindowFunction(WindowFunction value) {
+    if (_windowFunction == value)
+        return;
+
+    _windowFunction = value;
+    applyWindow();
+    emit windowFunctionChanged();
+}
+
+void WaterfallItem::setGoertzelFrequencies(const QVariantList &value) {
+    _goertzelFrequencies = value;
+    configureGoertzel();
+    emit goertzelFrequenciesChanged();
+}
+
+void WaterfallItem::setFilterTaps(const QVariantList &value) {
+    std::vector<float> taps;
+    taps.reserve(size_t(value.size()));
+    for (const QVariant &entry : value)
+        taps.push_back(entry.toFloat());
+
+    _filterTaps = value;
+    _sampler.setFilter(taps);
+    emit filterTapsChanged();
+}
 // === Sauvegarde des paramètres ===
 bool WaterfallItem::saveSettingsToJson(const QVariantMap &settings)
 {
@@ -1,12 +1,19 @@
 #pragma once
 
 #include <QQuickPaintedItem>
+#include <QFutureWatcher>
 #include <QImage>
 #include <QVariantMap>
 #include <vector>
 
 #include "audiosampler.h"
-#include "dft/radix2fft.h"
+#include "dft/dft.h"
+#include "dft/dfthandle.h"
+#include "dft/dftplanner.h"
+#include "dft/slidingdft.h"
+#include "dft/goertzelbank.h"
+#include "dft/magnitude.h"
+#include "dft/windowtable.h"
 
 // === Classe WaterfallItem (Qt6) ===
 // Affiche la transformation FFT des échantillons audio
@@ -22,10 +29,25 @@ class WaterfallItem : public QQuickPaintedItem
     Q_PROPERTY(float dominantFrequency READ dominantFrequency NOTIFY dominantFrequencyChanged)
     Q_PROPERTY(float smoothness READ smoothness WRITE setSmoothness NOTIFY smoothnessChanged) // ⬅️
     Q_PROPERTY(float barrenumbers READ barrenumber WRITE setBarrenumber NOTIFY barrenumberChanged) // ⬅️
+    Q_PROPERTY(int fftSize READ fftSize WRITE setFftSize NOTIFY fftSizeChanged)
+    Q_PROPERTY(int hopSize READ hopSize WRITE setHopSize NOTIFY hopSizeChanged)
+    Q_PROPERTY(bool fixedPoint READ fixedPoint WRITE setFixedPoint NOTIFY fixedPointChanged)
+    Q_PROPERTY(AnalysisMode analysisMode READ analysisMode WRITE setAnalysisMode NOTIFY analysisModeChanged)
+    Q_PROPERTY(WindowFunction windowFunction READ windowFunction WRITE setWindowFunction NOTIFY windowFunctionChanged)
+    Q_PROPERTY(QVariantList goertzelFrequencies READ goertzelFrequencies WRITE setGoertzelFrequencies NOTIFY goertzelFrequenciesChanged)
+    Q_PROPERTY(QVariantList filterTaps READ filterTaps WRITE setFilterTaps NOTIFY filterTapsChanged)
 
 public:
+    // FftAnalysis : spectre complet ; GoertzelAnalysis : seulement les fréquences de goertzelFrequencies
+    enum AnalysisMode { FftAnalysis, GoertzelAnalysis };
+    Q_ENUM(AnalysisMode)
+
+    // Fenêtre appliquée à chaque trame avant le FFT (même ordre que WindowType)
+    enum WindowFunction { RectangularWindow, HannWindow, BlackmanHarrisWindow, FlatTopWindow, KaiserWindow };
+    Q_ENUM(WindowFunction)
+
     explicit WaterfallItem(QQuickItem *parent = nullptr);
-    ~WaterfallItem() override = default;
+    ~WaterfallItem() override;
 
     QImage _gradientImg;
     void paint(QPainter *painter) override;
@@ -49,6 +71,37 @@ std::vector<float> _previousLevels;
     float barrenumber() const { return _barCount; }                // ⬅️
     void setBarrenumber(float value);
 
+    // Taille du FFT (nombre d'échantillons par trame)
+    int fftSize() const { return int(_sampleNumber); }
+    void setFftSize(int value);
+
+    // Saut du DFT glissant : 0 = un FFT par trame, 64 ... 256 = spectre tous les hopSize échantillons
+    // Au-delà de SlidingDft::defaultMaxPending (≈ 96 pour fftSize = 4096 en AVX2, moitié en SSE2),
+    // chaque spectre est un FFT complet : pas plus rapide que de tout recalculer à chaque saut
+    int hopSize() const { return int(_sampler.hopSize()); }
+    void setHopSize(int value);
+
+    // Chaîne int16 de bout en bout (FFT Q15, ~75 dB de SNR) pour les cartes ARM sans FPU rapide
+    // En mode Goertzel, les trames int16 sont converties en float pour le banc de filtres
+    bool fixedPoint() const { return _sampler.fixedPoint(); }
+    void setFixedPoint(bool value);
+
+    AnalysisMode analysisMode() const { return _analysisMode; }
+    void setAnalysisMode(AnalysisMode value);
+
+    // Hann par défaut ; sans effet en mode glissant et en mode Goertzel
+    WindowFunction windowFunction() const { return _windowFunction; }
+    void setWindowFunction(WindowFunction value);
+
+    // Liste de fréquences en Hz, ou de { frequency, blockLength } pour choisir la longueur de bloc
+    // (par défaut un nombre entier de périodes proche de fftSize)
+    QVariantList goertzelFrequencies() const { return _goertzelFrequencies; }
+    void setGoertzelFrequencies(const QVariantList &value);
+
+    // Coefficients du filtre FIR appliqué avant l'analyse (vide = aucun), retard de 256 échantillons
+    QVariantList filterTaps() const { return _filterTaps; }
+    void setFilterTaps(const QVariantList &value);
+
     // Sauvegarde / chargement des paramètres JSON
     Q_INVOKABLE bool saveSettingsToJson(const QVariantMap &settings);
     Q_INVOKABLE QVariantMap loadSettingsFromJson();
@@ -66,14 +119,45 @@ signals:
     void dominantFrequencyChanged();
     void smoothnessChanged(); // ⬅️
     void barrenumberChanged();
+    void fftSizeChanged();
+    void hopSizeChanged();
+    void fixedPointChanged();
+    void analysisModeChanged();
+    void windowFunctionChanged();
+    void goertzelFrequenciesChanged();
+    void filterTapsChanged();
 
 private slots:
-    void samplesCollected(std::vector<float> *samples);
+    void samplesCollected(const std::vector<float> &samples);
+    void samplesToWaitChanged(quint32 value);
+    void hopCollected(const std::vector<float> &samples);
+    void samplerHopSizeChanged(quint32 value);
+    void fixedPointSamplesCollected(const std::vector<qint16> &samples);
+    void samplerFixedPointChanged(bool value);
+    void planningFinished();
     void sizeChanged();
 
 private:
+    void createEngine();
+    void applyWindow();
+    void goertzelCollected(const std::vector<float> &samples);
+    void configureGoertzel();
+    void renderSpectrum(bool sparse = false);
+
     AudioSampler _sampler;
-    Radix2Fft *_dft;
+    DftPlanner _planner; // choisit le moteur FFT le plus rapide, mémorisé dans wisdom.json
+    QFutureWatcher<void> _planning; // mesure du planificateur en cours, hors du thread GUI
+    DftHandle _dft; // type concret mémorisé : appel direct, sans vtable, à chaque trame
+    SlidingDft *_sliding; // seulement en mode glissant (hopSize > 0)
+    AnalysisMode _analysisMode;
+    WindowFunction _windowFunction;
+    float _windowGain; // 1 / gain cohérent de la fenêtre : les barres gardent leur hauteur d'une fenêtre à l'autre
+    QVariantList _goertzelFrequencies;
+    QVariantList _filterTaps;
+    GoertzelBank _goertzel;
+    std::vector<float> _goertzelSamples; // trame int16 convertie pour le banc de Goertzel en mode virgule fixe
+    SplitSpectrum _bins; // sortie du FFT (parties réelles / imaginaires séparées), dimensionnée une seule fois par moteur
+    AlignedVector<float> _magnitudes; // module des N/2 + 1 premiers bins, lu par le dessin
 
     QImage _image;
     bool _samplesUpdated;